@@ -2,10 +2,12 @@
 #include "ControleurBase.h"
 #include "../include/Position.h"
 #include "Avion.h"
+#include "SequenceAtterrissage.h"
+#include "EtatPiste.h"
 #include <vector>
-#include <queue>
 #include <string>
 #include <mutex>
+#include <unordered_set>
 
 // Dclaration forward pour viter les dpendances circulaires
 class TWR;
@@ -17,17 +19,31 @@ private:
     float rayonControle;
 
     std::vector<Avion*> avionsEnApproche;
-    std::queue<std::string> fileAttenteAtterrissage;
+    std::unordered_set<IdAvion> idsEnApproche;      // Index de avionsEnApproche
+    SequenceAtterrissage sequenceAtterrissage;      // Avions en approche, par heure estime
+    std::vector<IdAvion> urgencesDeclarees;         // En attente de gererUrgences
+    int compteurCycles;                             // Cadence l'affichage console
+    InstantanePiste pisteConnue;                    // Dernier tat de piste notifi par la TWR
 
     TWR* towerReference;
     CCR* ccrReference;
 
     void gererDeparts();  
 
+    // Met pisteConnue  jour d'aprs les notifications releves ce cycle ;
+    // relit l'tat publi si une notification manque (bote pleine)
+    void actualiserPiste();
+
+    // Atterrissage estim  vitesse constante jusqu'au centre de la zone
+    double estimerAtterrissage(const EtatPublie& publie) const;
+
+    void avionDisparu(const Avion* avion, IdAvion id) override;
+
 public:
     // Constructeur
     APP(const std::string& nom, const Position& centre, float rayon,
         TWR* twr = nullptr, CCR* ccr = nullptr);
+    ~APP();
 
     // Mthode principale hrite de ControleurBase
     void processLogic() override;
@@ -40,8 +56,8 @@ public:
     std::vector<Avion*>& getAvionsEnApproche() { return avionsEnApproche; }
 
     // Setters
-    void setTWR(TWR* twr) { towerReference = twr; }
-    void setCCR(CCR* ccr) { ccrReference = ccr; }
+    void setTWR(TWR* twr);      // Abonne aussi l'APP  l'tat de piste de la TWR
+    void setCCR(CCR* ccr);      // Relie aussi l'APP au CCR (canaux de passation)
 
     // Vrification de prsence dans la zone
     bool estDansZone(const Avion& avion) const;
@@ -50,15 +66,19 @@ public:
     // Gestion des avions
     void ajouterAvionEnApproche(Avion* avion);
     void retirerAvionEnApproche(Avion* avion);
-    void transfererAvionVersCCR(Avion* avion);
 
     // Logique de contrle
     void gererNouvellesArrivees();
-   /* void gererUrgences();*/
+    void gererUrgences();
     void gererTrajectoires();
     void assignerTrajectoireCirculaire(Avion* avion, int niveau);
     bool demanderAutorisationAtterrissage(const std::string& avionId);
 
+    // Urgence dclare par un avion : il passe en tte de la squence
+    // d'atterrissage au prochain cycle (appelable de n'importe quel thread)
+    void declarerUrgence(IdAvion avion);
+    const SequenceAtterrissage& getSequenceAtterrissage() const { return sequenceAtterrissage; }
+
     // Affichage
     void afficherConsole() const;
 
@@ -0,0 +1,76 @@
+#ifndef ALLOCATEUR_PARKINGS_H
+#define ALLOCATEUR_PARKINGS_H
+
+#include "Position.h"
+#include "RegistreAvions.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+struct Parking {
+    std::string id;
+    bool occupee = false;
+    IdAvion avionActuel = RegistreAvions::ID_INVALIDE;
+    double distancePiste = 0.0;
+    Position position;
+};
+
+// Parkings d'un aéroport, numérotés de façon dense dans l'ordre de création.
+// Un bitmap des parkings libres, résumé par un second bitmap des mots non
+// vides, donne le premier parking libre en deux recherches de premier bit ;
+// un index inverse avion -> parking évite de parcourir les parkings pour
+// retrouver celui d'un avion. Allocation et libération en O(1).
+class AllocateurParkings {
+public:
+    static const int AUCUN = -1;
+
+private:
+    std::vector<Parking> parkings;                  // Par numéro
+    std::vector<std::uint64_t> libres;              // Un bit par parking libre
+    std::vector<std::uint64_t> resume;              // Un bit par mot de libres non nul
+    std::unordered_map<std::string, int> numeroParNom;
+    std::unordered_map<IdAvion, int> parkingParAvion;
+    size_t nbLibres;
+
+    void marquerLibre(int numero);
+    void marquerOccupe(int numero);
+
+public:
+    AllocateurParkings();
+
+    // Nouveau parking libre ; un nom déjà connu garde son numéro et son
+    // occupation (seules distance et position sont mises à jour)
+    int ajouter(const std::string& nom, double distancePiste, const Position& position);
+
+    size_t taille() const { return parkings.size(); }
+    size_t getNbLibres() const { return nbLibres; }
+    const Parking& get(int numero) const { return parkings[numero]; }
+
+    // AUCUN si le nom est inconnu
+    int trouver(const std::string& nom) const;
+
+    // Parking occupé par l'avion, AUCUN s'il n'en occupe pas
+    int parkingDe(IdAvion avion) const {
+        auto it = parkingParAvion.find(avion);
+        return it == parkingParAvion.end() ? AUCUN : it->second;
+    }
+
+    // Plus petit numéro libre, AUCUN si tout est occupé
+    int premierLibre() const;
+
+    // Attribue le parking à l'avion ; faux s'il est déjà occupé
+    bool occuper(int numero, IdAvion avion);
+
+    // Premier parking libre attribué à l'avion, AUCUN si complet
+    int allouer(IdAvion avion);
+
+    // Faux si le parking était déjà libre
+    bool liberer(int numero);
+
+    // Libère le parking de l'avion ; renvoie son numéro ou AUCUN
+    int libererAvion(IdAvion avion);
+};
+
+#endif // ALLOCATEUR_PARKINGS_H
@@ -0,0 +1,65 @@
+#ifndef ARENA_TEXTE_H
+#define ARENA_TEXTE_H
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+
+// Arène de textes libres d'un contrôleur, vidée d'un bloc à chaque cycle.
+// Les blocs sont conservés d'un cycle à l'autre : une fois la taille de
+// croisière atteinte, plus aucune allocation n'a lieu.
+// Les textes copiés ne sont valides que jusqu'au prochain reinitialiser().
+class ArenaTexte {
+private:
+    struct Bloc {
+        std::unique_ptr<char[]> donnees;
+        size_t taille;
+    };
+
+    static const size_t TAILLE_BLOC = 16 * 1024;
+
+    std::vector<Bloc> blocs;
+    size_t blocCourant;
+    size_t position;
+
+    ArenaTexte(const ArenaTexte&);
+    ArenaTexte& operator=(const ArenaTexte&);
+
+public:
+    ArenaTexte() : blocCourant(0), position(0) {}
+
+    const char* copier(const char* texte, size_t longueur) {
+        while (blocCourant < blocs.size() && position + longueur > blocs[blocCourant].taille) {
+            blocCourant++;
+            position = 0;
+        }
+
+        if (blocCourant == blocs.size()) {
+            Bloc b;
+            b.taille = longueur > TAILLE_BLOC ? longueur : TAILLE_BLOC;
+            b.donnees.reset(new char[b.taille]);
+            blocs.push_back(std::move(b));
+            position = 0;
+        }
+
+        char* copie = blocs[blocCourant].donnees.get() + position;
+        if (longueur > 0) std::memcpy(copie, texte, longueur);
+        position += longueur;
+        return copie;
+    }
+
+    // Libère d'un coup tous les textes du cycle
+    void reinitialiser() {
+        blocCourant = 0;
+        position = 0;
+    }
+
+    size_t getCapacite() const {
+        size_t total = 0;
+        for (const auto& b : blocs) total += b.taille;
+        return total;
+    }
+};
+
+#endif // ARENA_TEXTE_H
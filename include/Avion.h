@@ -3,12 +3,17 @@
 #define AVION_H
 
 #include "Position.h"
+#include "Flotte.h"
+#include "Horloge.h"
+#include "RegistreAvions.h"
+#include "FluxAleatoire.h"
+#include "PoolAvions.h"
+#include "ReseauDestinations.h"
 #include <string>
-#include <chrono>        
-#include <thread>        
 #include <cmath>
 #include <iostream>
-#include <random>
+#include <vector>
+#include <memory>
 
 // Énumérations
 enum class EtatAvion {
@@ -25,44 +30,44 @@ enum class EtatAvion {
 };
 
 class Avion {
+    friend class Flotte;
+    friend class PoolAvions;
+
 private:
     // Identification
     std::string nom;
+    IdAvion id;                         // Nom interné dans le registre des avions
+    PoigneeAvion poignee;               // Nulle si l'avion a été créé hors du pool
 
-    // Position et mouvement
-    Position position;
-    double vitesse;                     // Vitesse actuelle (m/s)
-    double cap;                         // Direction (0-360 degrés)
-    double altitude_cible;              // Altitude à atteindre
+    // Position, mouvement, état et destination sont stockés dans la flotte
+    // (structure de tableaux) : l'avion n'est qu'une vue sur son indice.
+    Flotte& flotte;
+    size_t indice;
 
     // Caractéristiques de vol
-    double vitesse_croisiere;           // Vitesse de croisière (m/s)
-    double vitesse_montee;              // Vitesse verticale en montée (m/s)
-    double vitesse_descente;            // Vitesse verticale en descente (m/s)
     double vitesse_roulage;             // Vitesse au sol (m/s)
 
-    // État
-    EtatAvion etat;
-
-    // Destination
-    Position destination;
-
-    // Contrôle d'exécution
-    bool enRoute;
-
     // Temps pour attente au parking
-    std::chrono::steady_clock::time_point tempsParkingDebut;
+    double tempsParkingDebut;           // Temps simulé (s)
     double tempsRoulageDebut;
 
-    static std::chrono::steady_clock::time_point tempsDebutSimulation;  
-    static bool simulationDemarree;
+    static Horloge* horloge;            // Horloge de simulation partagée
+    static std::uint64_t graineScenario;
+
+    // Tirages propres à l'avion, reproductibles pour une graine donnée
+    FluxAleatoire fluxDestinations;
+    FluxAleatoire fluxParking;
 
 
     // NOUVEAUX MEMBRES pour destinations multiples et cycles
-    std::vector<Position> destinationsPossibles;  
+    std::shared_ptr<const ReseauDestinations> reseau;  // Tables partagées par tous les avions du réseau
+    int destinationReseau;  // Indice de la destination dans le réseau (HORS_RESEAU sinon)
     Position positionDepart;  //  pour retenir le départ
+    Position pointDecollage;  // Aéroport quitté au dernier décollage (recherche de la route)
     int nombreVols;  //  compteur de vols effectués
     bool premierVol;  // pour distinguer le premier vol
+    bool volUnique;   // Vol isolé (CCR::creerVol) : l'avion quitte la simulation une fois stationné
+    bool termine;
 
     bool enParking;  
     int tempsAttenteParking;
@@ -71,19 +76,24 @@ private:
     double rayon_attente = 15000.0;
 
     // Méthodes internes de gestion du vol
+    // (les phases en vol sont avancées par les noyaux de la Flotte)
     void updateParking(double dt);
     void updateRoulageDecollage(double dt);
-    void updateDecollage(double dt);
-    void updateMontee(double dt);
-    void updateCroisiere(double dt);
-    void updateDescente(double dt);
-    void updateApproche(double dt);
-    void updateAtterrissage(double dt);
     void updateRoulageArrivee(double dt);
+    void appliquerTransition(double temps);
+
+    // Changement d'état effectif à l'instant donné (entrée en croisière :
+    // construction du plan de vol)
+    void changerEtat(EtatAvion nouvelEtat, double temps);
+    void entrerCroisiere(double temps);
 
     // Utilitaires
     double distanceVers(const Position& pos) const;
     double calculerCap(const Position& cible) const;
+    void direction(double& ux, double& uy) const;   // Cap ; en croisière, celui du tronçon courant
+    void setPosition(const Position& pos);
+    void setDestination(const Position& dest);
+    void setCap(double capDegres);
 
     std::string getEtatStringFromEnum(EtatAvion e) const {
         switch (e) {
@@ -103,50 +113,93 @@ private:
 public:
     // Constructeur
     Avion(const std::string& nom, const Position& pos_depart,
-        const std::vector<Position>& destinations);
+        const std::vector<Position>& destinations,
+        Flotte& flotte = Flotte::globale());
+    ~Avion();
 
     // Getters
     std::string getNom() const { return nom; }
-    Position getPosition() const { return position; }
-    double getVitesse() const { return vitesse; }
-    double getAltitude() const { return position.altitude; }
-    EtatAvion getEtat() const { return etat; }  
-    Position getDestination() const { return destination; }
-    double getCap() const { return cap; }
+    IdAvion getId() const { return id; }
+    PoigneeAvion getPoignee() const { return poignee; }
+    // En croisière, la position est évaluée à la demande le long du plan de vol
+    Position getPosition() const {
+        if (getEtat() == EtatAvion::CROISIERE) {
+            return flotte.positionCroisiere(indice, horloge->maintenant());
+        }
+        return Position(flotte.x[indice], flotte.y[indice], flotte.altitude[indice]);
+    }
+    double getVitesse() const { return flotte.vitesse[indice]; }
+    double getAltitude() const { return flotte.altitude[indice]; }
+    EtatAvion getEtat() const { return static_cast<EtatAvion>(flotte.etat[indice]); }
+    Position getDestination() const {
+        return Position(flotte.destX[indice], flotte.destY[indice], flotte.destAltitude[indice]);
+    }
+    double getCap() const;
+
+    // Vecteur vitesse (m/s) : horizontal selon le cap, vertical selon la phase de vol
+    double getVitesseX() const;
+    double getVitesseY() const;
+    double getVitesseVerticale() const;
+    size_t getIndice() const { return indice; }     // Change au retrait d'un autre avion (Flotte::retirer)
+
+    // Aéroport de destination (indice dans la table du CCR), remis à
+    // AEROPORT_INCONNU à chaque nouvelle destination
+    static const int AEROPORT_INCONNU = -1;
+    static const int AEROPORT_HORS_RESEAU = -2;
+    int getAeroportDestination() const { return flotte.aeroportDestination[indice]; }
+    void setAeroportDestination(int aeroport) { flotte.aeroportDestination[indice] = aeroport; }
 
     // Setters
     void setEtat(EtatAvion nouvelEtat) {
-        if (etat != nouvelEtat) {  // Afficher seulement si changement réel
-            std::cout << "[" << nom << "] " << getEtatString()
-                << " -> " << getEtatStringFromEnum(nouvelEtat) << "\n";
+        // Mode événementiel : un changement imposé de l'extérieur réveille l'avion
+        if (flotte.endormi[indice]) {
+            flotte.reveiller(indice, horloge->maintenant());
+        }
+        // Une croisière quittée repart de la position du dernier instantané
+        else if (getEtat() == EtatAvion::CROISIERE) {
+            flotte.evaluerCroisiere(indice, flotte.getTempsPublication());
         }
-        etat = nouvelEtat;
+        changerEtat(nouvelEtat, horloge->maintenant());
     }
 
     // Méthodes d'état
     std::string getEtatString() const {
-        return getEtatStringFromEnum(etat);
+        return getEtatStringFromEnum(getEtat());
     }
 
-    // Contrôle de l'avion
-    void demarrer();  // Démarre la boucle de mise à jour
-    void arreter() { enRoute = false; }  // Arrête l'avion
-
     // Méthode principale de mise à jour
     void update(double dt);  // dt = delta temps en secondes
 
+    // Fin de pas après les noyaux de la flotte : transitions et phases au sol
+    void finaliserPas(double dt);
+
+    // Instant (temps simulé) jusqu'auquel l'avion n'a rien à décider : fin
+    // d'attente au parking, ou seuil de descente d'une croisière.
+    // Faux si sa phase doit être intégrée pas à pas.
+    bool calculerReveil(double& temps) const;
+
     // Affichage
     void afficherEtat() const;
 
     // Vérification fin de vol
     bool volTermine() const;
 
+    // Vol unique : arrivé au parking, l'avion est marqué terminé et
+    // l'ordonnanceur le rend au pool
+    void setVolUnique(bool unique) { volUnique = unique; }
+    bool estTermine() const { return termine; }
+
     void choisirNouvelleDestination();
 
-    static void demarrerSimulation() {  
-        tempsDebutSimulation = std::chrono::steady_clock::now();
-        simulationDemarree = true;
-    }
+    // Horloge utilisée pour les attentes (temps réel par défaut). Elle doit
+    // survivre à son installation : l'ordonnanceur installe la sienne et
+    // remet la précédente à sa destruction
+    static void setHorloge(Horloge& h) { horloge = &h; }
+    static Horloge& getHorloge() { return *horloge; }
+
+    // Graine du scénario : à fixer avant de créer les avions
+    static void setGraineScenario(std::uint64_t graine) { graineScenario = graine; }
+    static std::uint64_t getGraineScenario() { return graineScenario; }
 
     void updateAttente(double dt);
 
@@ -154,11 +207,14 @@ public:
         centre_attente = centre;
 
         // Calculer l'angle initial basé sur la position actuelle
-        double dx = position.x - centre.x;
-        double dy = position.y - centre.y;
+        double dx = flotte.x[indice] - centre.x;
+        double dy = flotte.y[indice] - centre.y;
         angle_attente = atan2(dy, dx);
     }
-    
+
+private:
+    Avion(const Avion&);
+    Avion& operator=(const Avion&);
 };
 
 #endif // AVION_H
\ No newline at end of file
@@ -0,0 +1,178 @@
+#ifndef BOITE_AUX_LETTRES_H
+#define BOITE_AUX_LETTRES_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Statistiques de contre-pression d'une boîte aux lettres
+struct StatistiquesBoite {
+    unsigned long long envoyes = 0;     // Messages acceptés
+    unsigned long long refuses = 0;     // Envois refusés, boîte pleine
+    unsigned long long releves = 0;     // Messages retirés par le destinataire
+    size_t occupationMax = 0;           // Plus forte occupation observée
+    size_t capacite = 0;
+};
+
+// Boîte aux lettres bornée sans verrou, plusieurs producteurs / un consommateur.
+// Tableau circulaire de cellules numérotées (file de Vyukov) : un producteur
+// réserve une place par compare-and-swap sur la queue, écrit le message puis
+// publie la cellule ; le consommateur unique la lit sans jamais bloquer les
+// producteurs. Une boîte pleine refuse l'envoi au lieu de grossir.
+template <typename T>
+class BoiteAuxLettres {
+private:
+    struct Cellule {
+        std::atomic<size_t> sequence;
+        T valeur;
+    };
+
+    std::vector<Cellule> cellules;
+    size_t masque;
+
+    // Producteurs et consommateur sur des lignes de cache distinctes. Du
+    // remplissage plutôt qu'alignas(64) : la boîte est membre des
+    // contrôleurs, alloués par new, qui en C++11 ne respecte pas un
+    // alignement étendu ; 64 octets d'écart suffisent quel que soit
+    // l'alignement de l'objet.
+    char separationQueue[64];
+    std::atomic<size_t> queue;
+    char separationTete[64];
+    std::atomic<size_t> tete;   // Écrit par le seul consommateur
+    char separationStatistiques[64];
+
+    std::atomic<unsigned long long> nbEnvoyes;
+    std::atomic<unsigned long long> nbRefuses;
+    std::atomic<size_t> occupationMax;
+    std::atomic<unsigned long long> nbReleves;
+    char separationFin[64];
+
+    static size_t puissanceDeDeux(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    void noterOccupation(size_t occupation) {
+        size_t max = occupationMax.load(std::memory_order_relaxed);
+        while (occupation > max &&
+            !occupationMax.compare_exchange_weak(max, occupation, std::memory_order_relaxed)) {
+        }
+    }
+
+    BoiteAuxLettres(const BoiteAuxLettres&);
+    BoiteAuxLettres& operator=(const BoiteAuxLettres&);
+
+public:
+    // Capacité arrondie à la puissance de deux supérieure
+    explicit BoiteAuxLettres(size_t capacite = 1024)
+        : cellules(puissanceDeDeux(capacite)),
+        masque(cellules.size() - 1),
+        queue(0),
+        tete(0),
+        nbEnvoyes(0),
+        nbRefuses(0),
+        occupationMax(0),
+        nbReleves(0) {
+        for (size_t i = 0; i < cellules.size(); i++) {
+            cellules[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Producteurs : faux si la boîte est pleine (le message n'est pas déposé)
+    bool deposer(const T& valeur) {
+        return deposerAvec([&valeur](T& cellule) { cellule = valeur; });
+    }
+
+    // Producteurs : remplir(T&) écrit le message directement dans la cellule
+    // réservée, qui réutilise ainsi les ressources laissées par le précédent
+    template <typename F>
+    bool deposerAvec(F remplir) {
+        size_t position = queue.load(std::memory_order_relaxed);
+
+        while (true) {
+            Cellule& c = cellules[position & masque];
+            size_t sequence = c.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t ecart = static_cast<std::ptrdiff_t>(sequence) -
+                static_cast<std::ptrdiff_t>(position);
+
+            if (ecart == 0) {
+                if (queue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    remplir(c.valeur);
+                    c.sequence.store(position + 1, std::memory_order_release);
+                    nbEnvoyes.fetch_add(1, std::memory_order_relaxed);
+                    size_t t = tete.load(std::memory_order_relaxed);
+                    noterOccupation(position + 1 > t ? position + 1 - t : 0);
+                    return true;
+                }
+            }
+            else if (ecart < 0) {
+                // La cellule n'a pas encore été libérée par le consommateur
+                nbRefuses.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else {
+                position = queue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consommateur unique : faux si la boîte est vide
+    bool retirer(T& valeur) {
+        size_t position = tete.load(std::memory_order_relaxed);
+        Cellule& c = cellules[position & masque];
+        size_t sequence = c.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1) {
+            return false;
+        }
+
+        valeur = std::move(c.valeur);
+        c.sequence.store(position + cellules.size(), std::memory_order_release);
+        tete.store(position + 1, std::memory_order_relaxed);
+        nbReleves.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Consommateur unique : retire au plus max messages, appelle f(T&) sur
+    // chacun, en place, avant de rendre sa cellule aux producteurs
+    template <typename F>
+    size_t relever(size_t max, F f) {
+        size_t n = 0;
+        while (n < max) {
+            size_t position = tete.load(std::memory_order_relaxed);
+            Cellule& c = cellules[position & masque];
+            if (c.sequence.load(std::memory_order_acquire) != position + 1) {
+                break;
+            }
+
+            f(c.valeur);
+            c.sequence.store(position + cellules.size(), std::memory_order_release);
+            tete.store(position + 1, std::memory_order_relaxed);
+            nbReleves.fetch_add(1, std::memory_order_relaxed);
+            n++;
+        }
+        return n;
+    }
+
+    size_t getCapacite() const { return cellules.size(); }
+
+    // Occupation approximative (exacte si aucun envoi n'est en cours)
+    size_t taille() const {
+        size_t t = tete.load(std::memory_order_acquire);
+        size_t q = queue.load(std::memory_order_acquire);
+        return q > t ? q - t : 0;
+    }
+
+    StatistiquesBoite getStatistiques() const {
+        StatistiquesBoite s;
+        s.envoyes = nbEnvoyes.load(std::memory_order_relaxed);
+        s.refuses = nbRefuses.load(std::memory_order_relaxed);
+        s.releves = nbReleves.load(std::memory_order_relaxed);
+        s.occupationMax = occupationMax.load(std::memory_order_relaxed);
+        s.capacite = cellules.size();
+        return s;
+    }
+};
+
+#endif // BOITE_AUX_LETTRES_H
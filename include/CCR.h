@@ -3,8 +3,11 @@
 #include "Position.h"
 #include "ControleurBase.h"
 #include "APP.h"
-#include <map>
+#include "GrilleSpatiale.h"
+#include "SondeConflits.h"
+#include "PoolThreads.h"
 #include <string>
+#include <unordered_map>
 
 struct Aeroport {
     std::string nom;
@@ -14,6 +17,16 @@ struct Aeroport {
     int avionsEnApproche = 0;           
 };
 
+// Vol demand par CCR::creerVol, cr par l'ordonnanceur entre deux pas
+struct VolDemande {
+    std::string nomAvion;
+    std::string depart;
+    std::string arrivee;
+    int aeroportArrivee = -1;
+    Position positionDepart;
+    Position positionArrivee;
+};
+
 struct Route {
     std::string depart;
     std::string arrivee;
@@ -23,16 +36,49 @@ struct Route {
 
 class CCR : public ControleurBase {
 private:
-    std::map<std::string, Aeroport> aeroports;
+    // Table dense des aroports ; les avions rfrencent leur aroport de destination par indice
+    std::vector<Aeroport> aeroports;
+    std::unordered_map<std::string, size_t> indexAeroports;
     std::vector<Route> routes;
+    std::vector<VolDemande> volsDemandes;   // En attente de creerAvionsDemandes
     double altitudeCroisiere;
+    int compteurCycles;                     // Cadence l'affichage console
+
+    // Index spatial des avions sous contrle et positions lues au dernier rafrachissement
+    mutable GrilleSpatiale grille;
+    mutable std::vector<Position> positionsControle;
+
+    // Sonde de conflits  moyen terme, lance tous les PERIODE_SONDE cycles
+    SondeConflits sonde;
+    int compteurSonde;
+    static const int PERIODE_SONDE = 10;
+
+    // Pool prt pour la dtection parallle (nullptr : dtection squentielle)
+    PoolThreads* poolDetection;
+    static const size_t TAILLE_LOT_DETECTION = 256;
 
     void processLogic() override;
+    size_t creerAvionsDemandes() override;
+    void actualiserGrille() const;    // mtx doit tre tenu
+
+    // Paires (i < j) de la liste de contrle voisines dans la grille et
+    // vrifiant critere(pos1, pos2), tries ; mtx tenu, grille  jour
+    template <typename Critere>
+    std::vector<std::pair<size_t, size_t>> collecterPaires(double rayonH, double rayonV,
+        bool parallele, Critere critere) const;
 
     void gererSeparation();           // viter les collisions
+    void gererConflitsPrevus();       // Conflits prvus par la sonde
     void gererFlux();                 // Rguler le flux vers les aroports
     void transfererVersAPP();         // Transfrer les avions aux APP
-    bool verifierCapaciteAeroport(const std::string& aeroportId);
+    bool verifierCapaciteAeroport(size_t aeroport) const;
+
+    // Indice d'un aroport par son nom, -1 s'il n'existe pas
+    int trouverAeroport(const std::string& nom) const;
+
+    // Aroport de destination de l'avion, rsolu une seule fois par destination
+    // (aroport  moins de 10 km du point de destination), < 0 si hors rseau
+    int resoudreAeroportDestination(Avion* avion) const;
     double calculerSeparationMinimale(const Avion* a1, const Avion* a2) const;
 
 public:
@@ -45,7 +91,10 @@ public:
     // Gestion des routes
     void ajouterRoute(const std::string& depart, const std::string& arrivee);
 
-    // Crer un vol entre deux aroports
+    // Crer un vol entre deux aroports (de n'importe quel thread, y compris
+    // pendant un cycle) : la capacit d'arrive est rserve aussitt, l'avion
+    // est cr par l'ordonnanceur entre deux pas, puis rendu au pool une
+    // fois stationn  l'arrive
     void creerVol(const std::string& nomAvion, const std::string& depart,
         const std::string& arrivee);
 
@@ -55,9 +104,19 @@ public:
     // Vrifier les risques de collision
     std::vector<std::pair<std::string, std::string>> detecterRisquesCollision() const;
 
-    void recupererAvionsEnCroisiere();
+    // Dtection des conflits rpartie sur les threads d'un pool existant,
+    // en gnral celui de l'ordonnanceur (Ordonnanceur::getPool) : il est
+    // libre tant que le CCR est seul dans sa vague, sinon la dtection reste
+    // squentielle. nullptr : dtection squentielle
+    void activerDetectionParallele(PoolThreads* pool);
+    bool detectionParallele() const;
+
+    // Compare les dtections squentielle et parallle ; vrai si identiques
+    bool verifierDetectionParallele() const;
 
-    void recevoirAvionDepuisAPP(Avion* avion, const std::string& aeroportDepart);
+    // Conflits prvus sur l'horizon de la sonde (extrapolation cap/vitesse/taux vertical)
+    std::vector<ConflitPrevu> sonderConflits() const;
+    void setHorizonSonde(double secondes);
 };
 
 #endif // CCR_H
@@ -0,0 +1,67 @@
+#ifndef CALENDRIER_EVENEMENTS_H
+#define CALENDRIER_EVENEMENTS_H
+
+#include <vector>
+#include <queue>
+#include <cstdint>
+#include <cstddef>
+
+// Type de réveil planifié (mode événementiel de l'ordonnanceur)
+enum class TypeReveil : std::uint8_t {
+    AVION,          // Fin d'une phase prévisible (parking, croisière)
+    CONTROLEUR      // Cycle d'un contrôleur
+};
+
+struct ReveilPlanifie {
+    std::uint64_t tick;             // Instant, en pas de simulation
+    std::uint32_t cible;            // Indice de l'avion ou du contrôleur
+    std::uint32_t generation;       // Écarte les réveils périmés
+    TypeReveil type;
+};
+
+// File d'événements à roue temporelle (calendar queue).
+// Une case par pas de simulation sur un horizon de nbCases pas : planifier
+// et extraire sont en O(1), et un bitmap des cases occupées permet de sauter
+// directement au prochain événement quand la simulation est creuse.
+// Les événements au-delà de l'horizon attendent dans un tas et sont versés
+// dans la roue à mesure qu'elle tourne.
+// Les événements d'un même pas sont rendus dans un ordre déterministe.
+class CalendrierEvenements {
+private:
+    struct PlusTard {
+        bool operator()(const ReveilPlanifie& a, const ReveilPlanifie& b) const {
+            return a.tick > b.tick;
+        }
+    };
+
+    std::vector<std::vector<ReveilPlanifie>> cases;
+    std::vector<std::uint64_t> occupees;        // Un bit par case non vide
+    std::priority_queue<ReveilPlanifie, std::vector<ReveilPlanifie>, PlusTard> lointains;
+    std::uint64_t courant;                      // Plus petit tick encore extractible
+    size_t masque;
+    size_t nombre;
+
+    void placer(const ReveilPlanifie& r);
+    void verserLointains();
+    bool prochaineCaseOccupee(std::uint64_t& tick) const;
+
+public:
+    // nbCases arrondi à une puissance de deux (au moins 64)
+    explicit CalendrierEvenements(size_t nbCases = 4096, std::uint64_t debut = 0);
+
+    // r.tick < getCourant() est ramené au tick courant
+    void planifier(const ReveilPlanifie& r);
+
+    // Tick du prochain événement ; faux si le calendrier est vide
+    bool prochain(std::uint64_t& tick) const;
+
+    // Retire les événements du tick donné (>= getCourant()) et avance le
+    // curseur jusqu'à lui ; renvoie le nombre d'événements ajoutés à sortie
+    size_t extraire(std::uint64_t tick, std::vector<ReveilPlanifie>& sortie);
+
+    std::uint64_t getCourant() const { return courant; }
+    size_t taille() const { return nombre; }
+    bool vide() const { return nombre == 0; }
+};
+
+#endif // CALENDRIER_EVENEMENTS_H
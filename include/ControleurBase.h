@@ -7,59 +7,189 @@
 #include <fstream>
 #include <thread>
 #include <atomic>
+#include <memory>
+#include <unordered_map>
 #include "Avion.h"
+#include "Horloge.h"
+#include "RegistreAvions.h"
+#include "BoiteAuxLettres.h"
+#include "Message.h"
+#include "ArenaTexte.h"
+#include "JournalAsynchrone.h"
+#include "TraceBinaire.h"
+#include "HistoriqueMessages.h"
+#include "PoolAvions.h"
+#include "FileSPSC.h"
 
-// Structure pour les messages entre contrleurs
-struct Message {
-    std::string expediteur;
-    std::string destinataire;
-    std::string type;      // "DEMANDE_ATTERRISSAGE", "AUTORISATION", etc.
-    std::string avionId;
-    std::string contenu;
-    long timestamp = 0;
+// Rfrence d'un avion sous contrle : la poigne permet de savoir, sans
+// drfrencer l'avion, s'il a t rendu au pool
+struct ReferenceAvion {
+    PoigneeAvion poignee;
+    IdAvion id;
+};
+
+// Offre de passation d'un avion  un autre contrleur
+struct OffreTransfert {
+    Avion* avion;
+    ReferenceAvion reference;
+    int expediteur;                     // Propritaire jusqu' l'acceptation
+};
+
+typedef FileSPSC<OffreTransfert> CanalTransfert;
 
-    std::string toJSON() const;
+// Case de la bote de rception. Le texte libre d'un message AUTRE est
+// copi dans la case, qui en est propritaire jusqu' la relve : sa
+// capacit sert d'un message  l'autre.
+struct MessageRecu {
+    Message msg;
+    std::string texte;
 };
 
 class ControleurBase {
 protected:
     std::string nom;
-    std::vector<Avion*> avionsSousControle;
-    std::vector<Message> historiqueMessages;
+    int idControleur;                   // Identifiant dans le registre des avions
+    std::vector<Avion*> avionsSousControle;            // Vue rsolue, valide pendant le cycle
+    std::vector<ReferenceAvion> referencesSousControle; // Parallle  avionsSousControle
+    HistoriqueMessages historiqueMessages;     // Born : les anciens messages sont dverss sur disque
+    BoiteAuxLettres<MessageRecu> boiteReception;   // Dpose sans verrou, releve en dbut de cycle
+    std::vector<Message> tamponReleve;          // Rutilis d'un cycle  l'autre
+    ArenaTexte arena;                           // Textes libres du cycle en cours (mis et relevs)
     mutable std::mutex mtx;
-    std::ofstream logFile;
-    std::thread workerThread;
-    std::atomic<bool> running;
+    int fluxJournal;                    // Fichier de log dans le journal asynchrone
+    Horloge* horloge;                   // Horloge de simulation (temps rel par dfaut)
+    LectureFlotte lectureCycle;         // Instantan de la flotte pingl pendant le cycle
+    std::unordered_map<IdAvion, unsigned long long> decisions;  // Avion -> instantan de la dernire dcision
+
+    // Passations d'avions : un canal sans verrou par paire oriente de
+    // contrleurs relis, produit par le cycle de l'expditeur et relev par
+    // celui du destinataire (jamais de verrou de l'autre contrleur)
+    std::unordered_map<int, std::shared_ptr<CanalTransfert>> canauxSortants;   // Par destinataire
+    std::vector<std::shared_ptr<CanalTransfert>> canauxEntrants;
+
+    // Sorties des journaux, communes  tous les contrleurs
+    static std::atomic<bool> journalJSON;
+    static std::atomic<TraceBinaire*> trace;
+    static std::mutex mtxConfigurationHistorique;
+    static ConfigurationHistorique configurationHistorique;
 
     // Mthode virtuelle pure pour le traitement principal
     virtual void processLogic() = 0;
 
-    // Enregistre un message dans le log JSON
+    // Avion rendu au pool alors qu'il tait encore sous contrle ; l'adresse
+    // est prime et ne doit pas tre drfrence (thread du contrleur)
+    virtual void avionDisparu(const Avion*, IdAvion) {}
+
+    // carte en dbut de cycle les avions dont la poigne est prime ;
+    // renvoie leur nombre
+    size_t verifierPoignees();
+
+    // Retire l'avion des listes sans toucher au registre (thread du contrleur)
+    bool oublierAvion(const Avion* avion);
+
+    // Offre l'avion au destinataire (mtx tenu, thread du contrleur) : il
+    // quitte aussitt la liste, mais reste  ce contrleur dans le registre
+    // jusqu' son acceptation au cycle du destinataire. Faux si les deux
+    // contrleurs ne sont pas relis ou si le canal est plein : l'avion
+    // reste alors ici.
+    bool offrirAvion(Avion* avion, ControleurBase* destinataire);
+
+    // Accepte les offres reues (dbut de cycle) : la proprit passe par
+    // compare-and-swap dans le registre. Une offre dont l'avion a t rendu
+    // au pool ou repris par un autre contrleur est ignore ; un avion libr
+    // entre-temps est renvoy  l'expditeur par le canal retour. Renvoie le
+    // nombre d'avions accepts.
+    size_t accepterTransferts();
+
+    // tat d'un avion dans l'instantan du cycle : cohrent pour tous les
+    // avions et lu sans verrou (les modifications du cycle en cours n'y
+    // apparaissent qu'aprs la publication suivante)
+    EtatPublie etatPublie(const Avion* avion) const { return lectureCycle.etat(avion); }
+
+    // Change l'tat de l'avion en notant l'instantan sur lequel la dcision
+    // s'appuie (mtx tenu, thread du contrleur)
+    void appliquerEtat(Avion* avion, EtatAvion etat);
+
+    // Faux tant que l'instantan du cycle ne reflte pas la dernire dcision
+    // prise sur l'avion (publication saute par la flotte) : dcider sur cet
+    // tat prim rejouerait la transition dj applique
+    bool etatAJour(const Avion* avion);
+
+    // Enregistre un message dans le log JSON (criture diffre, par lots)
     void logMessage(const Message& msg);
-    void logAction(const std::string& action, const std::string& details);
+
+    // vnement typ : trace binaire et/ou JSON selon configurerJournaux()
+    void logEvenement(const EvenementTrace& evenement);
 
 public:
-    ControleurBase(const std::string& _nom);
+    ControleurBase(const std::string& _nom, size_t capaciteBoite = 1024);
     virtual ~ControleurBase();
 
-    // Gestion des avions
+    // Choix des sorties de journal (avant la cration des contrleurs) :
+    // JSON par contrleur et/ou trace binaire partage (nullptr : aucune)
+    static void configurerJournaux(bool json, TraceBinaire* traceBinaire);
+
+    // Historique des contrleurs crs ensuite (rpertoire des segments...)
+    static void configurerHistorique(const ConfigurationHistorique& configuration);
+    static ConfigurationHistorique getConfigurationHistorique();
+
+    // Gestion des avions (le registre suit le propritaire de chaque avion)
     void ajouterAvion(Avion* avion);
+    void retirerAvion(Avion* avion);
     void retirerAvion(const std::string& avionId);
+    bool possedeAvion(const Avion* avion) const {
+        return RegistreAvions::globale().estProprietaire(avion->getId(), idControleur);
+    }
     std::vector<Avion*> getAvions() const;
 
-    // Gestion des messages
-    void envoyerMessage(const Message& msg);
-    std::vector<Message> getMessagesRecus() const;
+    // Vrai si un cycle a quelque chose  traiter : avions sous contrle,
+    // messages ou offres en attente (mode vnementiel : sinon le contrleur dort)
+    bool aDuTravail() const;
+
+    // Relie deux contrleurs par une paire de canaux de passation (mise en
+    // place, avant le dmarrage des cycles) ; sans effet s'ils le sont dj
+    static void relier(ControleurBase& a, ControleurBase& b, size_t capacite = 256);
+    bool estRelie(const ControleurBase& autre) const {
+        return canauxSortants.count(autre.idControleur) != 0;
+    }
+
+    // Gestion des messages : dpt sans verrou, indpendant de la dure du
+    // cycle du destinataire ; faux si la bote est pleine (message refus).
+    // Le texte libre d'un message AUTRE est copi dans la case de la bote,
+    // puis dans l'arne du destinataire  la relve (seule l'action est interne).
+    bool envoyerMessage(const Message& msg);
+
+    // Historique des messages reus, parcouru sous le verrou du contrleur
+    // (le visiteur ne doit pas rappeler le contrleur)
+    size_t parcourirMessages(long debut, long fin, const HistoriqueMessages::Visiteur& f) const;
+    size_t parcourirMessagesAvion(IdAvion avion, const HistoriqueMessages::Visiteur& f) const;
+    size_t parcourirMessagesRecents(size_t n, const HistoriqueMessages::Visiteur& f) const;
+    StatistiquesHistorique getStatistiquesHistorique() const;
+    StatistiquesBoite getStatistiquesBoite() const { return boiteReception.getStatistiques(); }
+
+    // Relve les messages en attente dans l'historique (thread du contrleur) ;
+    // leurs textes libres restent valides jusqu'au cycle suivant
+    size_t releverMessages();
 
     std::vector<Avion*>& getAvionsSousControle() {
         return avionsSousControle;
     }
 
-    // Dmarrage et arrt du thread
-    void demarrer();
-    void arreter();
+    // Excute un cycle : relve des messages puis processLogic(). Seul
+    // l'ordonnanceur l'appelle (Ordonnanceur::ajouterControleur)
+    void executerCycle();
+
+    // Cre les avions demands depuis l'appel prcdent ; renvoie leur
+    // nombre. Appel par l'ordonnanceur en phase squentielle, entre deux
+    // pas : aucun cycle en cours, verrous du pool et de la flotte libres
+    virtual size_t creerAvionsDemandes() { return 0; }
+
+    // Horloge de simulation
+    void setHorloge(Horloge& h) { horloge = &h; }
+    Horloge& getHorloge() const { return *horloge; }
     
     std::string getNom() const { return nom; }
+    int getIdControleur() const { return idControleur; }
 };
 
 #endif 
\ No newline at end of file
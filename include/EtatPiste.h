@@ -0,0 +1,80 @@
+#ifndef ETAT_PISTE_H
+#define ETAT_PISTE_H
+
+#include "RegistreAvions.h"
+#include <atomic>
+#include <cstdint>
+
+// État de la piste tel que publié par la TWR
+struct InstantanePiste {
+    std::uint64_t sequence;             // Nombre de changements publiés
+    bool occupee;
+    IdAvion avion;                      // ID_INVALIDE si la piste est libre
+    double heureLiberation;             // Libération prévue (temps simulé, s)
+
+    InstantanePiste()
+        : sequence(0), occupee(false), avion(RegistreAvions::ID_INVALIDE), heureLiberation(0.0) {
+    }
+};
+
+// État de piste lisible sans verrou depuis n'importe quel thread.
+// Verrou de séquence : le rédacteur unique (la TWR, sous son verrou) rend
+// le compteur impair le temps d'écrire les champs ; un lecteur qui voit un
+// compteur impair ou modifié pendant sa lecture recommence. Le rédacteur
+// n'attend jamais les lecteurs.
+class EtatPiste {
+private:
+    std::atomic<std::uint64_t> compteur;   // Impair pendant une écriture
+    std::atomic<bool> occupee;
+    std::atomic<IdAvion> avion;
+    std::atomic<double> heureLiberation;
+
+    EtatPiste(const EtatPiste&);
+    EtatPiste& operator=(const EtatPiste&);
+
+public:
+    EtatPiste()
+        : compteur(0),
+        occupee(false),
+        avion(RegistreAvions::ID_INVALIDE),
+        heureLiberation(0.0) {
+    }
+
+    // Rédacteur unique ; renvoie le numéro de séquence publié
+    std::uint64_t publier(bool estOccupee, IdAvion id, double liberation) {
+        std::uint64_t c = compteur.load(std::memory_order_relaxed);
+        compteur.store(c + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        occupee.store(estOccupee, std::memory_order_relaxed);
+        avion.store(id, std::memory_order_relaxed);
+        heureLiberation.store(liberation, std::memory_order_relaxed);
+
+        compteur.store(c + 2, std::memory_order_release);
+        return (c + 2) / 2;
+    }
+
+    InstantanePiste lire() const {
+        InstantanePiste etat;
+        std::uint64_t avant;
+        std::uint64_t apres;
+        do {
+            avant = compteur.load(std::memory_order_acquire);
+            etat.occupee = occupee.load(std::memory_order_relaxed);
+            etat.avion = avion.load(std::memory_order_relaxed);
+            etat.heureLiberation = heureLiberation.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            apres = compteur.load(std::memory_order_relaxed);
+        } while ((avant & 1) != 0 || avant != apres);
+
+        etat.sequence = avant / 2;
+        return etat;
+    }
+
+    // Numéro du dernier changement publié (comparaison rapide)
+    std::uint64_t getSequence() const {
+        return compteur.load(std::memory_order_acquire) / 2;
+    }
+};
+
+#endif // ETAT_PISTE_H
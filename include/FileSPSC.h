@@ -0,0 +1,87 @@
+#ifndef FILE_SPSC_H
+#define FILE_SPSC_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// File bornée sans verrou, un producteur / un consommateur.
+// Tableau circulaire : le producteur n'écrit que la queue, le consommateur
+// que la tête, chacun sur sa ligne de cache ; chaque côté garde une copie
+// locale de l'indice de l'autre et ne relit l'atomique que lorsqu'elle ne
+// suffit plus. Ni compare-and-swap ni attente : une file pleine refuse le
+// dépôt.
+template <typename T>
+class FileSPSC {
+private:
+    std::vector<T> cellules;
+    size_t masque;
+
+    // Remplissage plutôt qu'alignas(64), que std::allocator (make_shared)
+    // ne respecte pas en C++11 : 64 octets d'écart séparent les deux côtés
+    // quel que soit l'alignement de l'objet
+    char separationQueue[64];
+    std::atomic<size_t> queue;                  // Écrit par le producteur
+    size_t teteConnue;                          // Copie locale du producteur
+
+    char separationTete[64];
+    std::atomic<size_t> tete;                   // Écrit par le consommateur
+    size_t queueConnue;                         // Copie locale du consommateur
+    char separationFin[64];
+
+    static size_t puissanceDeDeux(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    FileSPSC(const FileSPSC&);
+    FileSPSC& operator=(const FileSPSC&);
+
+public:
+    // Capacité arrondie à la puissance de deux supérieure
+    explicit FileSPSC(size_t capacite = 256)
+        : cellules(puissanceDeDeux(capacite)),
+        masque(cellules.size() - 1),
+        queue(0),
+        teteConnue(0),
+        tete(0),
+        queueConnue(0) {
+    }
+
+    // Producteur : faux si la file est pleine
+    bool deposer(const T& valeur) {
+        size_t q = queue.load(std::memory_order_relaxed);
+        if (q - teteConnue == cellules.size()) {
+            teteConnue = tete.load(std::memory_order_acquire);
+            if (q - teteConnue == cellules.size()) return false;
+        }
+
+        cellules[q & masque] = valeur;
+        queue.store(q + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consommateur : faux si la file est vide
+    bool retirer(T& valeur) {
+        size_t t = tete.load(std::memory_order_relaxed);
+        if (t == queueConnue) {
+            queueConnue = queue.load(std::memory_order_acquire);
+            if (t == queueConnue) return false;
+        }
+
+        valeur = std::move(cellules[t & masque]);
+        tete.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t getCapacite() const { return cellules.size(); }
+
+    // Lisible de n'importe quel thread (approximatif pendant un dépôt)
+    bool estVide() const {
+        return queue.load(std::memory_order_acquire) == tete.load(std::memory_order_acquire);
+    }
+};
+
+#endif // FILE_SPSC_H
@@ -0,0 +1,142 @@
+#ifndef FLOTTE_H
+#define FLOTTE_H
+
+#include "Position.h"
+#include "InstantaneFlotte.h"
+#include "PlanVol.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+class Avion;
+enum class EtatAvion;
+
+// Stockage de la flotte en structure de tableaux (SoA).
+// Chaque Avion n'est qu'une vue sur son indice dans ces colonnes, ce qui
+// permet aux noyaux cinématiques de traiter tous les avions d'un même état
+// en une seule passe vectorisée (AVX2 si disponible, scalaire sinon).
+class Flotte {
+public:
+    // Colonnes (une entrée par avion)
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> altitude;
+    std::vector<double> vitesse;
+    std::vector<double> dirX;               // Cap sous forme de vecteur unitaire
+    std::vector<double> dirY;
+    std::vector<double> destX;
+    std::vector<double> destY;
+    std::vector<double> destAltitude;
+    std::vector<double> altitudeCible;
+    std::vector<double> vitesseCroisiere;
+    std::vector<double> vitesseMontee;
+    std::vector<double> vitesseDescente;
+    std::vector<std::uint8_t> etat;         // EtatAvion
+    std::vector<std::uint8_t> transition;   // Etat suivant + 1 posé par un noyau (0 = aucun)
+    std::vector<std::int32_t> aeroportDestination;  // Indice dans la table des aéroports du CCR (-1 : inconnu)
+
+    // Croisière : position fonction du temps le long du plan de vol ;
+    // x, y, dirX et dirY ne sont évalués qu'à la lecture ou en sortie de
+    // croisière. Les plans, immuables, sont partagés avec les instantanés.
+    std::vector<std::shared_ptr<const PlanVol>> plans;
+    std::vector<double> debutCroisiere;             // Temps simulé d'entrée en croisière (abscisse 0)
+    std::vector<double> finCroisiere;               // Temps simulé du seuil de descente
+
+    // Mode événementiel : un avion endormi n'est pas intégré pas à pas, sa
+    // phase est prévisible jusqu'au réveil planifié par l'ordonnanceur
+    std::vector<std::uint8_t> endormi;
+    std::vector<std::uint32_t> generationReveil;    // Invalide les réveils planifiés périmés
+
+private:
+    std::vector<Avion*> avions;
+    mutable std::mutex mtx;
+    PublicationFlotte publication;
+    double tempsPublication;        // Instant du dernier instantané publié
+
+    void noyauDecollage(size_t debut, size_t fin, double dt);
+    void noyauMontee(size_t debut, size_t fin, double dt);
+    void noyauCroisiere(size_t debut, size_t fin, double temps);
+    void noyauDescente(size_t debut, size_t fin, double dt);
+    void noyauApproche(size_t debut, size_t fin, double dt);
+    void noyauAtterrissage(size_t debut, size_t fin, double dt);
+
+    Flotte(const Flotte&);
+    Flotte& operator=(const Flotte&);
+
+public:
+    explicit Flotte(size_t capacite = 4096);
+
+    // Flotte partagée par défaut par tous les avions
+    static Flotte& globale();
+
+    // Enregistrement des avions (appelé par le constructeur/destructeur d'Avion).
+    // Le retrait garde les colonnes denses : le dernier avion prend la place
+    // libérée et son Avion::indice est mis à jour ici, seul endroit où un
+    // indice change. Un indice n'est donc valable que jusqu'au retrait
+    // suivant : hors de la flotte on garde l'Avion* (ou sa PoigneeAvion) et
+    // on relit getIndice() sous le verrou de la flotte. Les réveils du
+    // calendrier, qui gardent des indices, sont périmés par generationReveil.
+    size_t enregistrer(Avion* avion);
+    void retirer(size_t indice);
+    void reserver(size_t capacite);
+
+    size_t taille() const { return avions.size(); }
+    Avion* getAvion(size_t indice) const { return avions[indice]; }
+
+    // Verrou à tenir pendant un pas complet pour bloquer les (dés)enregistrements
+    std::mutex& getMutex() const { return mtx; }
+
+    // Vrai si l'état est traité par un noyau cinématique
+    static bool estCinematique(EtatAvion etat);
+
+    // Avance tous les avions de [debut, fin) qui sont dans l'état donné,
+    // d'un pas dt se terminant à temps (secondes simulées)
+    void avancer(EtatAvion etat, size_t debut, size_t fin, double dt, double temps);
+
+    // Applique tous les noyaux sur [debut, fin)
+    void avancerCinematique(size_t debut, size_t fin, double dt, double temps);
+
+    // Entrée en croisière à l'instant donné, le long du plan
+    void demarrerCroisiere(size_t indice, std::shared_ptr<const PlanVol> plan, double temps);
+
+    // Distance parcourue le long d'un plan entamé à debut
+    static double abscisse(const PlanVol& plan, double debut, double vitesseCroisiere, double temps);
+
+    // Distance parcourue le long du plan, position et cap, à un instant donné
+    double abscisseCroisiere(size_t indice, double temps) const;
+    Position positionCroisiere(size_t indice, double temps) const;
+
+    // Cap d'un avion en croisière, tel que le montre le dernier instantané
+    void directionCroisiere(size_t indice, double& ux, double& uy) const;
+
+    // Écrit position et cap d'un avion en croisière à l'instant donné
+    void evaluerCroisiere(size_t indice, double temps);
+
+    // Endort un avion ; renvoie la génération du réveil à planifier
+    std::uint32_t endormir(size_t indice);
+
+    // Réveille un avion : une croisière est évaluée à l'instant donné et
+    // les réveils déjà planifiés deviennent périmés
+    void reveiller(size_t indice, double temps);
+
+    // Publie l'état de tous les avions à l'instant donné ; une croisière est
+    // publiée par son plan et évaluée par le lecteur (thread qui fait avancer
+    // la flotte, verrou de la flotte tenu, entre deux pas)
+    void publier(double temps);
+    double getTempsPublication() const { return tempsPublication; }
+
+    // Dernier instantané publié, lu sans verrou
+    LectureFlotte lire() const { return LectureFlotte(publication); }
+    unsigned long long getNbPublications() const { return publication.getNbPublications(); }
+
+    // Empreinte (FNV-1a) des colonnes d'état, au bit près, croisières
+    // évaluées à l'instant du dernier instantané
+    std::uint64_t empreinte() const;
+
+    // Vrai si les noyaux ont été compilés en AVX2
+    static bool noyauxSIMD();
+};
+
+#endif // FLOTTE_H
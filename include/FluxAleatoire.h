@@ -0,0 +1,126 @@
+#ifndef FLUX_ALEATOIRE_H
+#define FLUX_ALEATOIRE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Flux pseudo-aléatoire à compteur (Philox 4x32-10).
+// Le n-ième tirage est une fonction pure de (clé, flux, n) : il ne dépend
+// ni de l'ordre d'exécution des threads, ni des tirages des autres avions.
+// Chaque avion possède ses flux ; aucun état partagé, aucun verrou.
+//
+// La clé est dérivée de la graine du scénario et du nom de l'avion, le
+// numéro de flux sépare les usages (destinations, parking...). Le tirage
+// borné n'utilise pas les distributions de <random>, dont l'algorithme
+// varie selon la bibliothèque standard : les scénarios sont reproductibles
+// d'une plateforme à l'autre.
+class FluxAleatoire {
+private:
+    std::uint32_t cle[2];
+    std::uint32_t flux;
+    std::uint64_t compteur;     // Blocs de 4 mots déjà générés
+    std::uint32_t tampon[4];
+    unsigned disponibles;       // Mots restants dans le tampon
+
+    static std::uint64_t melanger(std::uint64_t x) {
+        // splitmix64
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    static void mulHiLo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+        std::uint64_t p = static_cast<std::uint64_t>(a) * b;
+        hi = static_cast<std::uint32_t>(p >> 32);
+        lo = static_cast<std::uint32_t>(p);
+    }
+
+    void generer() {
+        std::uint32_t c[4] = {
+            static_cast<std::uint32_t>(compteur),
+            static_cast<std::uint32_t>(compteur >> 32),
+            flux,
+            0
+        };
+        std::uint32_t k0 = cle[0];
+        std::uint32_t k1 = cle[1];
+
+        for (int tour = 0; tour < 10; tour++) {
+            std::uint32_t hi0, lo0, hi1, lo1;
+            mulHiLo(0xD2511F53u, c[0], hi0, lo0);
+            mulHiLo(0xCD9E8D57u, c[2], hi1, lo1);
+            c[0] = hi1 ^ c[1] ^ k0;
+            c[1] = lo1;
+            c[2] = hi0 ^ c[3] ^ k1;
+            c[3] = lo0;
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+
+        for (int i = 0; i < 4; i++) tampon[i] = c[i];
+        compteur++;
+        disponibles = 4;
+    }
+
+public:
+    // Usages réservés (numéros de flux)
+    enum Usage : std::uint32_t {
+        DESTINATIONS = 1,
+        PARKING = 2
+    };
+
+    FluxAleatoire(std::uint64_t graine, std::uint64_t sujet, std::uint32_t flux)
+        : flux(flux), compteur(0), disponibles(0) {
+        std::uint64_t k = melanger(graine ^ melanger(sujet));
+        cle[0] = static_cast<std::uint32_t>(k);
+        cle[1] = static_cast<std::uint32_t>(k >> 32);
+    }
+
+    // Identifiant stable d'un sujet (FNV-1a du nom)
+    static std::uint64_t sujet(const std::string& nom) {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < nom.size(); i++) {
+            h ^= static_cast<unsigned char>(nom[i]);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    std::uint32_t suivant() {
+        if (disponibles == 0) generer();
+        return tampon[4 - disponibles--];
+    }
+
+    // Entier uniforme dans [min, max] (multiplication de Lemire, sans biais)
+    int entier(int min, int max) {
+        std::uint32_t etendue = static_cast<std::uint32_t>(max - min) + 1u;
+        if (etendue == 0) return static_cast<int>(suivant());
+
+        std::uint64_t m = static_cast<std::uint64_t>(suivant()) * etendue;
+        std::uint32_t bas = static_cast<std::uint32_t>(m);
+        if (bas < etendue) {
+            std::uint32_t seuil = (0u - etendue) % etendue;
+            while (bas < seuil) {
+                m = static_cast<std::uint64_t>(suivant()) * etendue;
+                bas = static_cast<std::uint32_t>(m);
+            }
+        }
+        return min + static_cast<int>(m >> 32);
+    }
+
+    // Réel uniforme dans [0, 1)
+    double reel() {
+        // Deux tirages nommés : l'ordre d'évaluation des opérandes de ^ n'est pas spécifié
+        std::uint32_t haut = suivant();
+        std::uint32_t bas = suivant();
+        std::uint64_t x = (static_cast<std::uint64_t>(haut) << 21) ^ (bas >> 11);
+        return static_cast<double>(x & ((1ull << 53) - 1)) * (1.0 / 9007199254740992.0);
+    }
+
+    // Nombre de tirages effectués (mots consommés)
+    std::uint64_t getPosition() const { return compteur * 4 - disponibles; }
+};
+
+#endif // FLUX_ALEATOIRE_H
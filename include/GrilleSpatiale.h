@@ -0,0 +1,93 @@
+#ifndef GRILLE_SPATIALE_H
+#define GRILLE_SPATIALE_H
+
+#include "Position.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cmath>
+
+class Avion;
+
+// Grille uniforme (hachage spatial) : cellules horizontales carrées
+// découpées en tranches d'altitude. Mise à jour incrémentale : un avion
+// ne change de cellule que lorsqu'il en franchit la frontière.
+class GrilleSpatiale {
+public:
+    struct Entree {
+        Avion* avion;
+        Position position;   // Position copiée une seule fois par mise à jour
+        size_t rang;         // Rang fourni par l'appelant (ordre de la liste de contrôle)
+    };
+
+private:
+    struct Localisation {
+        std::int64_t cle;
+        size_t place;            // Indice dans la cellule
+        unsigned long generation;
+    };
+
+    double tailleCellule;        // Côté d'une cellule (m)
+    double hauteurTranche;       // Épaisseur d'une tranche d'altitude (m)
+
+    std::unordered_map<std::int64_t, std::vector<Entree>> cellules;
+    std::unordered_map<Avion*, Localisation> index;
+    unsigned long generation;
+
+    int coordonnee(double v, double taille) const {
+        return static_cast<int>(std::floor(v / taille));
+    }
+
+    static std::int64_t cle(int cx, int cy, int cz) {
+        return (static_cast<std::int64_t>(cx & 0xFFFFFF) << 40) |
+            (static_cast<std::int64_t>(cy & 0xFFFFFF) << 16) |
+            static_cast<std::int64_t>(cz & 0xFFFF);
+    }
+
+    std::int64_t cle(const Position& pos) const {
+        return cle(coordonnee(pos.x, tailleCellule), coordonnee(pos.y, tailleCellule),
+            coordonnee(pos.altitude, hauteurTranche));
+    }
+
+    void retirerDeCellule(std::int64_t c, size_t place);
+
+public:
+    GrilleSpatiale(double tailleCellule = 10000.0, double hauteurTranche = 1000.0);
+
+    // Mise à jour incrémentale : commencer, mettre à jour chaque avion présent,
+    // puis retirer ceux qui n'ont pas été vus pendant cette mise à jour
+    void commencerMiseAJour() { generation++; }
+    void mettreAJour(Avion* avion, const Position& pos, size_t rang);
+    void retirerAbsents();
+
+    void retirer(Avion* avion);
+    void vider();
+
+    size_t taille() const { return index.size(); }
+
+    // Appelle f(const Entree&) pour chaque avion des cellules pouvant contenir
+    // un point à moins de rayonH (horizontal) et rayonV (vertical) de pos
+    template <typename F>
+    void pourChaqueVoisin(const Position& pos, double rayonH, double rayonV, F f) const {
+        int xMin = coordonnee(pos.x - rayonH, tailleCellule);
+        int xMax = coordonnee(pos.x + rayonH, tailleCellule);
+        int yMin = coordonnee(pos.y - rayonH, tailleCellule);
+        int yMax = coordonnee(pos.y + rayonH, tailleCellule);
+        int zMin = coordonnee(pos.altitude - rayonV, hauteurTranche);
+        int zMax = coordonnee(pos.altitude + rayonV, hauteurTranche);
+
+        for (int cx = xMin; cx <= xMax; cx++) {
+            for (int cy = yMin; cy <= yMax; cy++) {
+                for (int cz = zMin; cz <= zMax; cz++) {
+                    auto it = cellules.find(cle(cx, cy, cz));
+                    if (it == cellules.end()) continue;
+                    for (const auto& e : it->second) {
+                        f(e);
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif // GRILLE_SPATIALE_H
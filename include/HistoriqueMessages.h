@@ -0,0 +1,96 @@
+#ifndef HISTORIQUE_MESSAGES_H
+#define HISTORIQUE_MESSAGES_H
+
+#include "RegistreAvions.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+struct Message;
+
+struct ConfigurationHistorique {
+    size_t capaciteMemoire = 4096;              // Messages gardés en mémoire
+    size_t tailleSegment = 4 * 1024 * 1024;     // Octets par segment projeté (4 Gio au plus)
+    size_t nbSegmentsMax = 16;                  // Au-delà, le plus ancien segment est supprimé
+    std::string repertoire;                     // Des segments ; vide : répertoire temporaire du système
+};
+
+struct StatistiquesHistorique {
+    unsigned long long enregistres = 0;         // Messages reçus depuis le début
+    unsigned long long deverses = 0;            // Messages écrits dans un segment
+    unsigned long long supprimes = 0;           // Messages perdus avec un segment supprimé
+    unsigned long long rejetes = 0;             // Plus gros qu'un segment, jamais déversés
+                                                // (ou segment impossible à créer)
+    size_t enMemoire = 0;
+    size_t nbSegments = 0;
+};
+
+// Historique borné des messages d'un contrôleur.
+// Les plus récents sont gardés dans un anneau en mémoire ; quand il est
+// plein, le plus ancien est sérialisé dans un segment de fichier projeté en
+// mémoire (mmap). Seuls les segments récents sont conservés : l'empreinte
+// mémoire et disque reste constante quelle que soit la durée de simulation.
+//
+// Un message dont l'enregistrement dépasse la taille d'un segment n'est
+// jamais tronqué : il est rejeté au déversement et compté comme tel.
+//
+// Les parcours se font dans l'ordre d'arrivée, sans copie de l'historique ;
+// chaque segment garde ses horodatages extrêmes et un filtre des avions
+// cités, ce qui évite de relire les segments hors de la requête.
+//
+// Non protégé : l'appelant (ControleurBase) sérialise les accès.
+class HistoriqueMessages {
+public:
+    typedef std::function<void(const Message&)> Visiteur;
+
+private:
+    class Segment;
+
+    ConfigurationHistorique configuration;
+    std::string prefixe;                        // Chemin des segments : <repertoire>/<nom>_<n>.seg
+
+    std::unique_ptr<Message[]> anneau;
+    std::unique_ptr<std::string[]> textesLibres;    // Texte libre des messages AUTRE, par case
+    size_t tete;                                // Plus ancien message en mémoire
+    size_t nombre;
+
+    std::vector<std::unique_ptr<Segment>> segments;     // Du plus ancien au plus récent
+    unsigned long numeroSegment;
+
+    unsigned long long nbEnregistres;
+    unsigned long long nbDeverses;
+    unsigned long long nbSupprimes;
+    unsigned long long nbRejetes;
+
+    void deverser(const Message& msg);
+    Segment* segmentCourant(size_t tailleRequise);
+
+    HistoriqueMessages(const HistoriqueMessages&);
+    HistoriqueMessages& operator=(const HistoriqueMessages&);
+
+public:
+    // nom : préfixe des fichiers de segment dans configuration.repertoire
+    explicit HistoriqueMessages(const std::string& nom,
+        const ConfigurationHistorique& configuration = ConfigurationHistorique());
+    ~HistoriqueMessages();
+
+    void ajouter(const Message& msg);
+
+    // Messages d'horodatage dans [debut, fin] ; renvoie le nombre visité
+    size_t parcourirIntervalle(long debut, long fin, const Visiteur& f) const;
+
+    // Messages concernant un avion (Message::concerne) ; un identifiant
+    // recyclé couvre aussi les vols précédents qui l'ont porté
+    size_t parcourirAvion(IdAvion avion, const Visiteur& f) const;
+
+    // Les n messages les plus récents (en mémoire uniquement)
+    size_t parcourirRecents(size_t n, const Visiteur& f) const;
+
+    size_t taille() const;
+    StatistiquesHistorique getStatistiques() const;
+};
+
+#endif // HISTORIQUE_MESSAGES_H
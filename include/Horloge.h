@@ -0,0 +1,64 @@
+#ifndef HORLOGE_H
+#define HORLOGE_H
+
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+// Horloge de simulation injectable, partagée par les avions et les contrôleurs.
+// Le temps est exprimé en secondes simulées depuis le début de la simulation.
+class Horloge {
+public:
+    virtual ~Horloge() {}
+
+    // Temps simulé courant (secondes)
+    virtual double maintenant() const = 0;
+
+    // Horloge temps réel utilisée par défaut
+    static Horloge& systeme();
+};
+
+// Temps réel (steady_clock), éventuellement accéléré
+class HorlogeReelle : public Horloge {
+private:
+    std::chrono::steady_clock::time_point debut;
+    double facteurTemps;
+
+public:
+    explicit HorlogeReelle(double facteurTemps = 1.0)
+        : debut(std::chrono::steady_clock::now()), facteurTemps(facteurTemps) {
+    }
+
+    double maintenant() const override {
+        std::chrono::duration<double> ecoule = std::chrono::steady_clock::now() - debut;
+        return ecoule.count() * facteurTemps;
+    }
+};
+
+// Temps virtuel avancé explicitement par l'ordonnanceur : la simulation
+// peut tourner aussi vite que le CPU le permet, sans fenêtre.
+class HorlogeVirtuelle : public Horloge {
+private:
+    std::atomic<std::int64_t> nanosecondes;
+
+public:
+    HorlogeVirtuelle() : nanosecondes(0) {}
+
+    double maintenant() const override {
+        return nanosecondes.load() * 1e-9;
+    }
+
+    void avancer(double dt) {
+        nanosecondes.fetch_add(static_cast<std::int64_t>(dt * 1e9 + 0.5));
+    }
+
+    // Place l'horloge à un instant donné (mode événementiel : sauts sans
+    // cumul d'arrondis)
+    void positionner(double temps) {
+        nanosecondes.store(static_cast<std::int64_t>(temps * 1e9 + 0.5));
+    }
+
+    void reinitialiser() { nanosecondes.store(0); }
+};
+
+#endif // HORLOGE_H
@@ -0,0 +1,130 @@
+#ifndef INSTANTANE_FLOTTE_H
+#define INSTANTANE_FLOTTE_H
+
+#include "Position.h"
+#include "RegistreAvions.h"
+#include "PlanVol.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+class Avion;
+enum class EtatAvion;
+
+// État publié d'un avion, copié en fin de pas (position et cap d'une
+// croisière : voir InstantaneFlotte::evaluer)
+struct EtatPublie {
+    IdAvion id;
+    std::uint8_t etat;
+    double x;
+    double y;
+    double altitude;
+    double vitesse;
+    double dirX;
+    double dirY;
+
+    Position getPosition() const { return Position(x, y, altitude); }
+    EtatAvion getEtat() const { return static_cast<EtatAvion>(etat); }
+    double getVitesseX() const { return vitesse * dirX; }
+    double getVitesseY() const { return vitesse * dirY; }
+};
+
+// Croisière publiée : plan partagé et instant d'entrée, la position se
+// déduit du temps de l'instantané
+struct CroisierePubliee {
+    std::shared_ptr<const PlanVol> plan;    // Nul hors croisière
+    double debut = 0.0;
+    double vitesseCroisiere = 0.0;
+};
+
+// Instantané de toute la flotte à un instant de simulation donné
+struct InstantaneFlotte {
+    double temps = 0.0;                     // Temps simulé du pas publié
+    unsigned long long numero = 0;          // Numéro de publication (0 : aucune)
+    std::vector<EtatPublie> avions;
+    std::vector<CroisierePubliee> croisieres;   // Parallèle à avions
+    std::vector<std::uint32_t> indiceParId; // IdAvion -> indice dans avions (vérifié par id)
+
+    // État publié (élément de avions), croisière évaluée au temps de l'instantané
+    EtatPublie evaluer(const EtatPublie& publie) const;
+
+    // nullptr si l'avion n'existait pas au moment de la publication
+    const EtatPublie* trouver(IdAvion id) const {
+        if (id >= indiceParId.size()) return nullptr;
+        std::uint32_t i = indiceParId[id];
+        return i < avions.size() && avions[i].id == id ? &avions[i] : nullptr;
+    }
+};
+
+// Publication des instantanés : un rédacteur (le thread qui fait avancer la
+// flotte), un nombre quelconque de lecteurs, sans verrou.
+// Plusieurs tampons tournent : le rédacteur remplit un tampon qui n'est ni le
+// dernier publié ni lu par personne, puis le publie d'un seul store atomique.
+// Un lecteur épingle le dernier tampon publié (compteur de lecteurs) et le
+// lit sans copie ; si tous les autres tampons sont épinglés, le rédacteur
+// saute simplement la publication de ce pas, il n'attend jamais.
+class PublicationFlotte {
+public:
+    static const int NB_TAMPONS = 4;
+
+private:
+    InstantaneFlotte tampons[NB_TAMPONS];
+    std::atomic<int> courant;                       // Dernier tampon publié (-1 : aucun)
+    mutable std::atomic<unsigned> lecteurs[NB_TAMPONS];
+    unsigned long long nbPublications;              // Rédacteur uniquement
+    std::atomic<unsigned long long> nbSautees;
+
+    PublicationFlotte(const PublicationFlotte&);
+    PublicationFlotte& operator=(const PublicationFlotte&);
+
+public:
+    PublicationFlotte();
+
+    // Rédacteur : tampon libre à remplir, nullptr si aucun
+    InstantaneFlotte* preparer();
+    void publier(InstantaneFlotte* instantane);
+
+    // Lecteurs : indice du tampon épinglé (-1 si rien n'est encore publié)
+    int epingler() const;
+    void liberer(int tampon) const;
+    const InstantaneFlotte& getTampon(int tampon) const { return tampons[tampon]; }
+
+    unsigned long long getNbPublications() const { return nbPublications; }
+    unsigned long long getNbSautees() const { return nbSautees.load(std::memory_order_relaxed); }
+};
+
+// Lecture épinglée d'un instantané, relâchée à la destruction.
+// Toutes les lectures voient le même pas de simulation.
+class LectureFlotte {
+private:
+    const PublicationFlotte* publication;
+    int tampon;
+
+    LectureFlotte(const LectureFlotte&);
+    LectureFlotte& operator=(const LectureFlotte&);
+
+public:
+    LectureFlotte() : publication(nullptr), tampon(-1) {}
+    explicit LectureFlotte(const PublicationFlotte& p) : publication(&p), tampon(p.epingler()) {}
+    LectureFlotte(LectureFlotte&& autre) : publication(autre.publication), tampon(autre.tampon) {
+        autre.tampon = -1;
+    }
+    LectureFlotte& operator=(LectureFlotte&& autre);
+    ~LectureFlotte() { liberer(); }
+
+    void liberer();
+
+    bool estValide() const { return tampon >= 0; }
+    const InstantaneFlotte* getInstantane() const {
+        return tampon >= 0 ? &publication->getTampon(tampon) : nullptr;
+    }
+    double getTemps() const { return tampon >= 0 ? publication->getTampon(tampon).temps : 0.0; }
+
+    // État publié de l'avion ; à défaut (avion créé depuis la dernière
+    // publication, ou aucune publication) lecture directe de la flotte
+    EtatPublie etat(const Avion* avion) const;
+};
+
+#endif // INSTANTANE_FLOTTE_H
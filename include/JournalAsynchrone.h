@@ -0,0 +1,111 @@
+#ifndef JOURNAL_ASYNCHRONE_H
+#define JOURNAL_ASYNCHRONE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstddef>
+
+struct Message;
+
+// Politique lorsqu'un anneau est plein
+enum class PolitiqueJournal {
+    ABANDONNER,     // L'enregistrement est perdu et compté
+    BLOQUER         // Le producteur attend que le rédacteur libère de la place
+};
+
+struct ConfigurationJournal {
+    unsigned intervalleVidageMs = 100;      // Période d'écriture des lots
+    size_t capaciteAnneau = 4096;           // Enregistrements en attente par fichier
+    PolitiqueJournal politique = PolitiqueJournal::ABANDONNER;
+};
+
+struct StatistiquesJournal {
+    unsigned long long ecrits = 0;          // Enregistrements écrits sur disque
+    unsigned long long abandonnes = 0;      // Perdus, anneau plein (politique ABANDONNER)
+    unsigned long long attentes = 0;        // Attentes d'un producteur (politique BLOQUER)
+    unsigned long long lots = 0;            // Lots écrits
+};
+
+// Journal asynchrone par lots.
+// Chaque fichier a son anneau : les messages d'un contrôleur y restent dans
+// l'ordre de production, quel que soit le thread du pool qui exécute son
+// cycle. Les producteurs d'un même fichier se succèdent sous le verrou de
+// l'anneau (sans concurrence en pratique : un contrôleur écrit pendant son
+// cycle). Un thread rédacteur relève périodiquement tous les anneaux,
+// sérialise les messages en JSON et écrit chaque fichier en un seul bloc
+// suivi d'un seul flush.
+class JournalAsynchrone {
+private:
+    struct Enregistrement;
+    class Anneau;
+
+    // Fichier de sortie (un par contrôleur)
+    struct Flux {
+        std::ofstream fichier;
+        std::string tampon;     // Lot en cours de constitution
+    };
+
+    ConfigurationJournal configuration;     // Protégée par mtxRedacteur (et mtxAnneaux pour la capacité)
+    const unsigned long identifiant;        // Distingue les instances pour les caches par thread
+    std::atomic<bool> bloquer;              // Politique BLOQUER, lue sans verrou par les producteurs
+    std::atomic<bool> reveil;               // Un anneau se remplit : passage anticipé du rédacteur
+
+    std::mutex mtxAnneaux;
+    std::vector<std::unique_ptr<Anneau>> anneaux;   // Indexé par identifiant de flux
+
+    std::mutex mtxFlux;                     // Protège les fichiers (rédacteur et ouverture/fermeture)
+    std::vector<std::unique_ptr<Flux>> flux;
+
+    mutable std::mutex mtxRedacteur;
+    std::condition_variable cvRedacteur;
+    std::condition_variable cvVidage;
+    std::thread redacteur;
+    bool arret;
+    unsigned long demandesVidage;           // Vidages demandés
+    unsigned long vidagesEffectues;         // Vidages terminés
+
+    std::atomic<unsigned long long> nbEcrits;
+    std::atomic<unsigned long long> nbAbandonnes;
+    std::atomic<unsigned long long> nbAttentes;
+    std::atomic<unsigned long long> nbLots;
+
+    Anneau& anneauDe(int idFlux);
+    void boucleRedacteur();
+    void relever();                         // Un passage du rédacteur
+
+    JournalAsynchrone(const JournalAsynchrone&);
+    JournalAsynchrone& operator=(const JournalAsynchrone&);
+
+public:
+    explicit JournalAsynchrone(const ConfigurationJournal& configuration = ConfigurationJournal());
+    ~JournalAsynchrone();
+
+    // Journal partagé par tous les contrôleurs
+    static JournalAsynchrone& globale();
+
+    // La capacité ne s'applique qu'aux anneaux créés ensuite
+    void configurer(const ConfigurationJournal& configuration);
+    ConfigurationJournal getConfiguration() const;
+
+    // Ouvre un fichier JSON (tableau de messages) ; renvoie l'identifiant de flux
+    int ouvrir(const std::string& chemin);
+
+    // Écrit tout ce qui est en attente puis ferme le fichier
+    void fermer(int idFlux);
+
+    // Dépose un message ; faux s'il a été abandonné
+    bool ecrire(int idFlux, const Message& msg);
+
+    // Bloque jusqu'à ce que tout ce qui a été déposé avant l'appel soit écrit
+    void vider();
+
+    StatistiquesJournal getStatistiques() const;
+};
+
+#endif // JOURNAL_ASYNCHRONE_H
@@ -0,0 +1,115 @@
+#ifndef MESSAGE_H
+#define MESSAGE_H
+
+#include "RegistreAvions.h"
+#include "TableTextes.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Types d'événements et de messages des contrôleurs
+enum class TypeEvenement : std::uint16_t {
+    AUTRE,                  // Texte libre (action et contenu quelconques)
+    AJOUT_AEROPORT,
+    AJOUT_ROUTE,
+    ERREUR_ROUTE,
+    ERREUR_VOL,
+    VOL_RETARDE,
+    VOL_CREE,
+    CONFLIT_DETECTE,
+    CONFLIT_PREVU,
+    AEROPORT_SATURE,
+    TRANSFERT_APP,
+    RECUPERATION_AVION,
+    AVION_DEJA_PRESENT,
+    AVION_RECU_APP,
+    AVION_AJOUTE,
+    AVION_RETIRE,
+    ENTREE_ZONE_APPROCHE,
+    TRAJECTOIRE_ASSIGNEE,
+    DEMANDE_NOUVEL_APP,
+    TRANSFERT_CCR,
+    INIT_PARKINGS,
+    AUTORISATION_ATTERRISSAGE,
+    LIBERATION_PARKING,
+    ROULAGE_VERS_PARKING,
+    AVION_STATIONNE,
+    AUTORISATION_DECOLLAGE,
+    POIGNEE_PERIMEE,
+    PISTE_OCCUPEE,          // Notifications de la TWR à ses abonnés :
+    PISTE_LIBEREE,          // valeur1 = libération prévue (s), valeur2 = séquence
+    URGENCE_PRIORISEE,
+    NB_TYPES
+};
+
+// Événement typé tel que produit par un contrôleur.
+// Les textes (noms d'aéroports, de parkings...) ne sont pas copiés : ils
+// doivent rester valides pendant l'appel.
+struct EvenementTrace {
+    TypeEvenement type = TypeEvenement::AUTRE;
+    IdAvion avion1 = RegistreAvions::ID_INVALIDE;
+    IdAvion avion2 = RegistreAvions::ID_INVALIDE;
+    const std::string* texte1 = nullptr;
+    const std::string* texte2 = nullptr;
+    double valeur1 = 0.0;       // Distance, niveau, rayon... selon le type
+    double valeur2 = 0.0;
+
+    EvenementTrace(TypeEvenement type = TypeEvenement::AUTRE) : type(type) {}
+};
+
+// Nom de l'action dans les journaux JSON ("CONFLIT_DETECTE"...)
+const char* nomTypeEvenement(TypeEvenement type);
+
+// Champ "contenu" des journaux JSON, reconstruit à partir des champs typés
+void ajouterContenu(std::string& sortie, TypeEvenement type, const std::string& avion1,
+    const std::string& avion2, const std::string& texte1, const std::string& texte2,
+    double valeur1, double valeur2);
+std::string formaterContenu(TypeEvenement type, const std::string& avion1,
+    const std::string& avion2, const std::string& texte1, const std::string& texte2,
+    double valeur1, double valeur2);
+
+// Charge utile d'un événement typé (champs selon le type, voir EvenementTrace)
+struct ChargeEvenement {
+    IdAvion avion1;
+    IdAvion avion2;
+    IdTexte texte1;
+    IdTexte texte2;
+    double valeur1;
+    double valeur2;
+};
+
+// Charge utile d'un message AUTRE : action internée, contenu libre.
+// Le contenu n'appartient pas au message (arène du cycle, texte interné...) :
+// ceux qui le conservent au-delà du cycle en font une copie.
+struct TexteLibre {
+    IdTexte action;
+    std::uint32_t longueur;
+    const char* texte;
+};
+
+// Message entre contrôleurs (ou vers le journal), de taille fixe et copiable
+// sans allocation : type énuméré, contrôleurs et avions par identifiant.
+struct Message {
+    static const std::int16_t JOURNAL = -1;     // Destinataire des messages de log
+
+    TypeEvenement type;
+    std::int16_t expediteur;            // Identifiant de contrôleur (registre)
+    std::int16_t destinataire;          // Identifiant de contrôleur ou JOURNAL
+    IdAvion avion;                      // Avion concerné, ID_INVALIDE si aucun
+    std::int64_t timestamp;             // Millisecondes de temps simulé
+
+    union {
+        ChargeEvenement evenement;      // Tous les types sauf AUTRE
+        TexteLibre libre;               // AUTRE
+    } charge;
+
+    Message();
+
+    // Vrai si l'avion est cité par le message
+    bool concerne(IdAvion id) const;
+
+    std::string toJSON() const;
+    void ajouterJSON(std::string& sortie) const;   // Sérialise à la suite de sortie
+};
+
+#endif // MESSAGE_H
@@ -0,0 +1,165 @@
+#ifndef ORDONNANCEUR_H
+#define ORDONNANCEUR_H
+
+#include "Avion.h"
+#include "Flotte.h"
+#include "PoolThreads.h"
+#include "Horloge.h"
+#include "ControleurBase.h"
+#include "CalendrierEvenements.h"
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// Cadence d'un contrôleur sous l'ordonnanceur
+struct StatistiquesCadence {
+    unsigned long long cycles = 0;          // Cycles exécutés
+    unsigned long long cyclesManques = 0;   // Échéances passées sans cycle (pas de rattrapage)
+    double dureeMax = 0.0;                  // Plus long cycle (secondes réelles)
+};
+
+// Ordonnanceur de simulation à pas fixe.
+// Possède tous les avions de sa flotte et les fait avancer par lots
+// contigus sur un petit pool de threads, au lieu d'un thread système par
+// avion. La flotte est la seule liste des avions : pas de copie à tenir à
+// jour ni d'avion avancé sans appartenir à l'ordonnanceur.
+// Chaque pas est découpé en phases (voir tick()) : les contrôleurs décident
+// sur l'état publié du pas précédent (par vagues, chacune en parallèle sur
+// le pool), les noyaux cinématiques calculent en
+// parallèle, puis les avions finalisent leur pas un par un dans l'ordre
+// des indices. Le résultat ne dépend ni du nombre de threads ni de leur
+// entrelacement.
+// Le temps simulé est porté par une horloge virtuelle avancée à chaque pas :
+// en mode sans affichage la simulation tourne aussi vite que le CPU le permet.
+//
+// Le mode événementiel (executerEvenements) ne fait plus avancer que ce qui
+// change : les avions en phase prévisible (attente au parking, croisière le
+// long du plan de vol) dorment jusqu'à un réveil planifié dans un calendrier, les
+// contrôleurs sans avion ni message ne sont plus cadencés, et l'horloge saute
+// directement au prochain événement quand plus rien n'est à intégrer.
+class Ordonnanceur {
+private:
+    // Contrôleur cadencé par l'ordonnanceur (mode sans affichage)
+    struct ControleurCadence {
+        ControleurBase* controleur;
+        double periode;              // Secondes simulées entre deux cycles
+        double prochainCycle;
+        int vague;
+        size_t indice;               // Dans controleurs (les copies y reportent leurs statistiques)
+        StatistiquesCadence statistiques;
+    };
+
+    mutable std::mutex mtx;          // Protège la liste des contrôleurs
+    std::vector<Avion*> volsTermines;   // Relevés pendant la validation du pas
+    Flotte& flotte;
+
+    std::vector<ControleurCadence> controleurs;
+
+    PoolThreads pool;
+    HorlogeVirtuelle horloge;
+    Horloge* horlogeAvionsPrecedente;   // Rendue aux avions à la destruction
+    std::thread threadBoucle;
+    std::atomic<bool> running;
+
+    double frequence;                // Ticks par seconde (Hz)
+    double facteurTemps;             // Temps simulé par seconde réelle
+    size_t tailleLot;                // Nombre d'avions par lot
+
+    std::atomic<unsigned long long> nbTicks;
+    std::atomic<unsigned long long> nbTicksEnRetard;
+
+    void boucle();
+    void cadencerControleurs();
+
+    // Cycles des contrôleurs donnés (dans l'ordre d'ajout) : vague par vague,
+    // les contrôleurs d'une même vague en parallèle sur le pool ; chaque
+    // cycle est compté et chronométré dans sa cadence
+    void executerVagues(std::vector<ControleurCadence*>& aExecuter);
+
+    // Recopie les statistiques de cadences copiées dans controleurs
+    void reporterStatistiques(const std::vector<ControleurCadence>& copies);
+
+    // Bilan des cycles de contrôleurs en fin de simulation sans affichage
+    void afficherCadences() const;
+
+    // Rend au pool les avions dont le vol est terminé (hors du verrou de la
+    // flotte, entre deux pas) ; les contrôleurs qui les suivaient encore
+    // trouvent des poignées périmées à leur cycle suivant
+    void retirerVolsTermines();
+    void detruire(Avion* avion);
+
+    // Crée les avions demandés par les contrôleurs pendant leurs cycles
+    // (ControleurBase::creerAvionsDemandes), dans l'ordre d'ajout des
+    // contrôleurs, hors du verrou de la flotte ; renvoie leur nombre
+    size_t creerAvionsDemandes();
+
+    // Mode événementiel : un pas d'intégration des avions éveillés, qui
+    // endort ceux dont la phase devient prévisible ; renvoie le nombre
+    // d'avions restés éveillés (integres : avions avancés pendant ce pas)
+    size_t integrerEveilles(std::uint64_t tick, double dt, CalendrierEvenements& calendrier,
+        unsigned long long& integres);
+
+    Ordonnanceur(const Ordonnanceur&);
+    Ordonnanceur& operator=(const Ordonnanceur&);
+
+public:
+    // nbThreads = 0 : un thread par coeur
+    Ordonnanceur(size_t nbThreads = 0, double frequence = 60.0,
+        double facteurTemps = 3.0, size_t tailleLot = 1024,
+        Flotte& flotte = Flotte::globale());
+    ~Ordonnanceur();
+
+    // Tout avion de la flotte appartient à l'ordonnanceur (rendu au pool,
+    // ou détruit s'il a été créé hors du pool, à la fin de son vol ou avec
+    // l'ordonnanceur). Vérifie que l'avion est bien dans sa flotte ; faux
+    // sinon (il ne serait jamais avancé)
+    bool ajouterAvion(Avion* avion);
+    size_t getNbAvions() const;
+
+    // Contrôleurs exécutés à chaque période de temps simulé par tick(), seul
+    // moteur de leurs cycles. Les vagues échues passent dans l'ordre
+    // croissant ; les contrôleurs d'une même vague tournent en parallèle et
+    // ne doivent donc pas s'appeler l'un l'autre pendant leur cycle (un
+    // contrôleur peut appeler ceux d'une autre vague, ou leur écrire par
+    // boîte aux lettres et canal de passation).
+    void ajouterControleur(ControleurBase* controleur, double periode = 0.3, int vague = 0);
+
+    // Cycles exécutés, échéances manquées (pas trop long pour la période, ou
+    // cycle précédent trop long en temps réel) et plus long cycle d'un
+    // contrôleur ; statistiques nulles s'il n'est pas cadencé ici
+    StatistiquesCadence getStatistiques(const ControleurBase* controleur) const;
+
+    // Avance tous les avions d'un pas dt (secondes simulées)
+    void tick(double dt);
+
+    // Boucle temps réel à pas fixe
+    void demarrer();
+    void arreter();
+
+    // Simule dureeSimulee secondes sans affichage ni attente, aussi vite que possible
+    void executerSansAffichage(double dureeSimulee);
+
+    // Idem en mode événementiel (même pas de temps, instants sautés quand
+    // rien n'est à intégrer)
+    void executerEvenements(double dureeSimulee);
+
+    // Horloge de simulation : installée pour les avions pendant toute la vie
+    // de l'ordonnanceur (Avion::setHorloge), à partager avec les contrôleurs
+    HorlogeVirtuelle& getHorloge() { return horloge; }
+
+    double getFrequence() const { return frequence; }
+    double getPas() const { return facteurTemps / frequence; }
+    size_t getNbThreads() const { return pool.getNbThreads(); }
+
+    // Pool des vagues et de la cinématique, libre pendant le cycle d'un
+    // contrôleur seul dans sa vague (CCR::activerDetectionParallele)
+    PoolThreads& getPool() { return pool; }
+    unsigned long long getNbTicks() const { return nbTicks.load(); }
+    unsigned long long getNbTicksEnRetard() const { return nbTicksEnRetard.load(); }
+
+    // Empreinte de l'état de la flotte, pour comparer deux exécutions
+    unsigned long long getEmpreinte() const;
+};
+
+#endif // ORDONNANCEUR_H
@@ -0,0 +1,90 @@
+#ifndef PLAN_VOL_H
+#define PLAN_VOL_H
+
+#include "Position.h"
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Tronçon rectiligne d'un plan de vol
+struct Troncon {
+    double x, y;            // Origine
+    double ux, uy;          // Direction (vecteur unitaire)
+    double longueur;
+    double abscisse;        // Distance parcourue depuis le début du plan à l'origine
+};
+
+// Plan de vol : suite de tronçons entre points de passage.
+// La position est une fonction de l'abscisse curviligne (distance le long
+// de la route) : elle se calcule en forme close, sans intégration pas à pas
+// et donc sans dérive sur les longs tronçons.
+class PlanVol {
+private:
+    std::vector<Troncon> troncons;
+    double longueur;
+
+public:
+    PlanVol();
+
+    // Les points confondus sont ignorés ; un seul point donne un plan de longueur nulle
+    explicit PlanVol(const std::vector<Position>& points);
+
+    bool estVide() const { return troncons.empty(); }
+    double getLongueur() const { return longueur; }
+    size_t getNbTroncons() const { return troncons.size(); }
+
+    // Point à l'abscisse s (bornée à [0, longueur]) et direction du tronçon
+    void evaluer(double s, double& x, double& y, double& ux, double& uy) const;
+};
+
+// Route déclarée au CCR : départ, points de passage, arrivée
+struct RouteDeclaree {
+    Position depart;
+    Position arrivee;
+    std::vector<Position> points;
+};
+
+// Routes déclarées au CCR, consultées par les avions pour construire leur
+// plan de vol en entrant en croisière.
+// Les routes sont déclarées à l'initialisation et lues à chaque entrée en
+// croisière : chaque ajout publie une nouvelle table immuable (copie sur
+// écriture), lue sans verrou. Les tables remplacées sont gardées jusqu'à la
+// destruction du réseau, un lecteur pouvant encore les parcourir. Un index
+// par cellule d'arrivée évite le parcours de toutes les routes.
+class ReseauRoutes {
+private:
+    struct Table {
+        std::vector<std::shared_ptr<const RouteDeclaree>> routes;      // Ordre de déclaration
+        std::unordered_map<std::uint64_t, std::vector<size_t>> parArrivee; // Cellule -> indices croissants
+    };
+
+    std::atomic<const Table*> courante;
+    std::vector<std::unique_ptr<const Table>> tables;   // Toutes les tables publiées
+    std::mutex mtx;                                     // Sérialise les ajouts
+
+    void publier(std::unique_ptr<Table> table);
+
+    ReseauRoutes(const ReseauRoutes&);
+    ReseauRoutes& operator=(const ReseauRoutes&);
+
+public:
+    ReseauRoutes();
+
+    static ReseauRoutes& globale();
+
+    // points : départ, points de passage, arrivée
+    void ajouter(const std::vector<Position>& points);
+
+    // Première route déclarée dont le départ et l'arrivée sont à moins de
+    // tolerance mètres des points donnés ; nullptr si aucune
+    std::shared_ptr<const RouteDeclaree> trouver(const Position& depart, const Position& arrivee,
+        double tolerance = 10000.0) const;
+
+    void vider();
+};
+
+#endif // PLAN_VOL_H
@@ -0,0 +1,103 @@
+#ifndef POOL_AVIONS_H
+#define POOL_AVIONS_H
+
+#include "Position.h"
+#include "Flotte.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+class Avion;
+
+// Poignée générationnelle sur un avion du pool : indice d'emplacement et
+// génération de l'occupant. Une poignée dont l'avion a été libéré est
+// reconnue comme périmée, même si l'emplacement a été réattribué.
+struct PoigneeAvion {
+    static const std::uint32_t AUCUN = 0xFFFFFFFFu;
+
+    std::uint32_t emplacement;
+    std::uint32_t generation;       // Impaire tant que l'occupant est vivant
+
+    PoigneeAvion() : emplacement(AUCUN), generation(0) {}
+    PoigneeAvion(std::uint32_t e, std::uint32_t g) : emplacement(e), generation(g) {}
+
+    // Avion créé hors du pool
+    bool estNulle() const { return emplacement == AUCUN; }
+
+    bool operator==(const PoigneeAvion& autre) const {
+        return emplacement == autre.emplacement && generation == autre.generation;
+    }
+    bool operator!=(const PoigneeAvion& autre) const { return !(*this == autre); }
+};
+
+struct StatistiquesPool {
+    size_t vivants;
+    size_t emplacements;            // Emplacements déjà construits (vivants + libres)
+    unsigned long long crees;
+    unsigned long long recycles;    // Créations dans un emplacement déjà servi
+};
+
+// Pool des avions de la simulation.
+// Les avions sont construits en place dans des pages de taille fixe,
+// contiguës et jamais déplacées ; un emplacement libéré est réutilisé en
+// priorité (dernier libéré, premier servi) : un flot continu de vols
+// n'alloue plus de mémoire une fois le régime atteint.
+// Les contrôleurs se passent des poignées : obtenir() rend nullptr pour une
+// poignée périmée au lieu d'un pointeur vers un avion détruit. La lecture
+// est sans verrou ; créer et libérer prennent le mutex du pool.
+// Ordre des verrous : pool puis flotte (la construction et la destruction
+// d'un avion l'enregistrent dans la flotte).
+class PoolAvions {
+private:
+    struct Emplacement;             // Défini dans PoolAvions.cpp (contient un Avion)
+
+    static const size_t TAILLE_PAGE = 256;
+    static const size_t NB_PAGES_MAX = 4096;        // 1 M avions simultanés
+
+    mutable std::mutex mtx;
+    std::unique_ptr<Emplacement[]> pages[NB_PAGES_MAX];
+    std::atomic<size_t> nbEmplacements;
+    std::uint32_t premierLibre;     // Tête de la liste des emplacements libres
+    size_t nbVivants;
+    unsigned long long nbCrees;
+    unsigned long long nbRecycles;
+
+    Emplacement& emplacement(std::uint32_t i) const;
+    std::uint32_t reserver();       // Sous mtx
+
+    PoolAvions(const PoolAvions&);
+    PoolAvions& operator=(const PoolAvions&);
+
+public:
+    PoolAvions();
+    ~PoolAvions();                  // Détruit les avions encore vivants
+
+    // Pool partagé par toute la simulation
+    static PoolAvions& globale();
+
+    // Construit un avion dans un emplacement libre
+    PoigneeAvion creer(const std::string& nom, const Position& depart,
+        const std::vector<Position>& destinations,
+        Flotte& flotte = Flotte::globale());
+
+    // Avion désigné par la poignée ; nullptr si elle est nulle ou périmée
+    Avion* obtenir(PoigneeAvion p) const;
+
+    // Vrai si la poignée désignait un avion du pool qui a été libéré
+    bool estPerimee(PoigneeAvion p) const {
+        return !p.estNulle() && obtenir(p) == nullptr;
+    }
+
+    // Détruit l'avion et rend son emplacement ; faux si la poignée est
+    // nulle ou déjà périmée. Aucun autre thread ne doit utiliser l'avion
+    // (l'ordonnanceur libère pendant sa phase séquentielle).
+    bool liberer(PoigneeAvion p);
+
+    StatistiquesPool getStatistiques() const;
+};
+
+#endif // POOL_AVIONS_H
@@ -0,0 +1,57 @@
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstddef>
+
+// Pool de threads de taille fixe pour le calcul par lots.
+// Le thread appelant participe au calcul : paralleliser() découpe [0, n)
+// en lots contigus que chaque thread récupère à tour de rôle.
+class PoolThreads {
+public:
+    // (debut, fin, indiceThread) - l'appelant a l'indice 0
+    typedef std::function<void(size_t, size_t, size_t)> TacheLot;
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable cvTravail;
+    std::condition_variable cvFin;
+
+    // Description du travail en cours
+    const TacheLot* tache;
+    size_t nbElements;
+    size_t tailleLot;
+    std::atomic<size_t> prochainLot;
+
+    unsigned long generation;   // Incrémentée à chaque appel de paralleliser()
+    size_t workersTermines;
+    bool arret;
+    std::atomic<bool> occupe;   // Un paralleliser() est en cours
+
+    void boucleWorker(size_t indice);
+    void executerLots(size_t indice);
+
+    PoolThreads(const PoolThreads&);
+    PoolThreads& operator=(const PoolThreads&);
+
+public:
+    // nbThreads = 0 : un thread par coeur
+    explicit PoolThreads(size_t nbThreads = 0);
+    ~PoolThreads();
+
+    // Applique f sur [0, n) par lots de tailleLot, bloque jusqu'à la fin.
+    // Appelé pendant un autre paralleliser() du même pool (depuis l'une de
+    // ses tâches, ou d'un autre thread), f s'exécute sur l'appelant seul
+    void paralleliser(size_t n, size_t tailleLot, const TacheLot& f);
+
+    // Nombre total de threads de calcul (workers + appelant)
+    size_t getNbThreads() const { return workers.size() + 1; }
+};
+
+#endif // POOL_THREADS_H
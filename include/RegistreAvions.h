@@ -0,0 +1,123 @@
+#ifndef REGISTRE_AVIONS_H
+#define REGISTRE_AVIONS_H
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include "TableTextes.h"
+
+class ControleurBase;
+
+typedef std::uint32_t IdAvion;
+
+// Registre central des avions : les noms sont internés en identifiants
+// entiers, et le contrôleur propriétaire de chaque avion est lu en O(1).
+// Les propriétaires sont rangés dans des pages de taille fixe jamais
+// déplacées : les lectures et les transferts se font sans verrou, par
+// opérations atomiques. Seul l'internement d'un nouveau nom prend le mutex.
+// Les identifiants des avions détruits sont recyclés après une quarantaine,
+// pour que le registre reste borné par le nombre d'avions vivants.
+class RegistreAvions {
+public:
+    static const IdAvion ID_INVALIDE = 0xFFFFFFFFu;
+    static const int AUCUN_CONTROLEUR = -1;
+
+    // Identifiants libérés en attente avant réattribution : laisse au journal
+    // et aux références périmées des contrôleurs le temps de s'écouler
+    static const size_t QUARANTAINE = 1024;
+
+private:
+    static const size_t TAILLE_PAGE = 4096;
+    static const size_t NB_PAGES_MAX = 4096;        // 16 M avions
+    static const size_t NB_CONTROLEURS_MAX = 1024;
+
+    static const std::uint32_t PERMANENT = 0xFFFFFFFFu;
+
+    mutable std::mutex mtx;                         // Protège l'internement
+    std::unordered_map<std::string, IdAvion> ids;
+    std::deque<std::string> noms;                   // Indexé par IdAvion ; conservé jusqu'à la réattribution
+    std::vector<std::uint32_t> references;          // Indexé par IdAvion ; PERMANENT si interné
+    std::deque<IdAvion> libres;                     // File de quarantaine
+    int suspensionsRecyclage;
+
+    std::unique_ptr<std::atomic<int>[]> pages[NB_PAGES_MAX];
+    std::atomic<size_t> nbIds;
+
+    std::atomic<ControleurBase*> controleurs[NB_CONTROLEURS_MAX];
+    std::atomic<IdTexte> nomsControleurs[NB_CONTROLEURS_MAX];   // Conservés après désenregistrement
+    std::atomic<int> nbControleurs;
+
+    std::atomic<int>& proprietaireRef(IdAvion id) const {
+        return pages[id / TAILLE_PAGE][id % TAILLE_PAGE];
+    }
+
+    // Identifiant du nom, nouveau ou sorti de quarantaine ; mutex tenu
+    IdAvion attribuerId(const std::string& nom);
+
+    RegistreAvions(const RegistreAvions&);
+    RegistreAvions& operator=(const RegistreAvions&);
+
+public:
+    RegistreAvions();
+
+    // Registre partagé par toute la simulation
+    static RegistreAvions& globale();
+
+    // Identifiant permanent d'un nom (créé au premier appel) ; jamais recyclé
+    IdAvion interner(const std::string& nom);
+
+    // Identifiant d'un nom avec une référence de plus ; le même tant qu'une
+    // référence est tenue, recyclable après le dernier relacher()
+    IdAvion acquerir(const std::string& nom);
+    void relacher(IdAvion id);
+
+    // Suspend la réattribution (trace dont le dictionnaire est écrit à la fermeture)
+    void suspendreRecyclage();
+    void reprendreRecyclage();
+
+    // Identifiant d'un nom vivant ou interné, ID_INVALIDE sinon
+    IdAvion trouver(const std::string& nom) const;
+
+    // Par valeur : l'emplacement peut être réattribué après la quarantaine
+    std::string getNom(IdAvion id) const;
+
+    // Identifiants attribués (vivants, en quarantaine ou internés)
+    size_t taille() const { return nbIds.load(std::memory_order_acquire); }
+
+    // Contrôleurs : identifiant entier attribué à l'enregistrement
+    int enregistrerControleur(ControleurBase* controleur, const std::string& nom);
+    void desenregistrerControleur(int idControleur);
+    ControleurBase* getControleur(int idControleur) const;
+    const std::string& getNomControleur(int idControleur) const;
+
+    // Propriété d'un avion (AUCUN_CONTROLEUR si personne)
+    int proprietaire(IdAvion id) const {
+        return proprietaireRef(id).load(std::memory_order_acquire);
+    }
+    bool estProprietaire(IdAvion id, int idControleur) const {
+        return proprietaire(id) == idControleur;
+    }
+
+    // Attribue l'avion à vers ; renvoie l'ancien propriétaire
+    int attribuer(IdAvion id, int vers) {
+        return proprietaireRef(id).exchange(vers, std::memory_order_acq_rel);
+    }
+
+    // Passation atomique : réussit seulement si de est toujours propriétaire
+    bool transferer(IdAvion id, int de, int vers) {
+        return proprietaireRef(id).compare_exchange_strong(de, vers, std::memory_order_acq_rel);
+    }
+
+    // Libère l'avion si idControleur en est propriétaire
+    bool liberer(IdAvion id, int idControleur) {
+        return transferer(id, idControleur, AUCUN_CONTROLEUR);
+    }
+};
+
+#endif // REGISTRE_AVIONS_H
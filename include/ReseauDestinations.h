@@ -0,0 +1,89 @@
+#ifndef RESEAU_DESTINATIONS_H
+#define RESEAU_DESTINATIONS_H
+
+#include "Position.h"
+#include "FluxAleatoire.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Destinations possibles au départ d'un aéroport du réseau : aéroports à
+// plus de DISTANCE_MIN de l'origine, ou à défaut le plus éloigné.
+// Le tirage pondéré est en O(1) par la méthode des alias (Vose) : une case
+// uniforme, puis au plus un réel pour choisir entre la case et son alias.
+class TableDestinations {
+private:
+    std::vector<std::uint32_t> candidats;   // Indices dans le réseau
+    std::vector<double> seuils;             // Probabilité de garder la case
+    std::vector<std::uint32_t> alias;
+    bool uniforme;                          // Seuils tous à 1 : pas de second tirage
+    bool tirage;                            // Faux pour le repli (aucun tirage consommé)
+
+public:
+    TableDestinations(const std::vector<Position>& aeroports,
+        const std::vector<double>& poids, size_t origine, double distanceMin);
+
+    bool estVide() const { return candidats.empty(); }
+    size_t taille() const { return candidats.size(); }
+
+    // Indice de l'aéroport tiré ; la table doit être non vide
+    size_t tirer(FluxAleatoire& flux) const {
+        if (!tirage) return candidats[0];
+
+        size_t k = static_cast<size_t>(flux.entier(0, static_cast<int>(candidats.size()) - 1));
+        if (!uniforme && flux.reel() >= seuils[k]) {
+            k = alias[k];
+        }
+        return candidats[k];
+    }
+};
+
+// Réseau de destinations partagé, immuable une fois construit : les tables
+// de chaque aéroport d'origine sont précalculées une fois pour toutes et
+// communes à tous les avions du réseau. Choisir une destination au départ
+// d'un aéroport du réseau n'alloue rien.
+class ReseauDestinations {
+public:
+    static constexpr double DISTANCE_MIN = 50000.0;        // Destinations trop proches écartées (m)
+    static constexpr double TOLERANCE_ORIGINE = 5000.0;    // Avion considéré à l'aéroport (m)
+    static const int HORS_RESEAU = -1;
+
+private:
+    std::vector<Position> aeroports;
+    std::vector<double> poids;                  // Vide : destinations équiprobables
+    std::vector<TableDestinations> tables;      // Une par aéroport d'origine
+
+public:
+    // poids : un par aéroport (vide ou somme nulle : tirage uniforme)
+    explicit ReseauDestinations(const std::vector<Position>& aeroports,
+        const std::vector<double>& poids = std::vector<double>());
+
+    // Réseau commun à tous les appelants qui donnent la même liste
+    static std::shared_ptr<const ReseauDestinations> partager(const std::vector<Position>& aeroports,
+        const std::vector<double>& poids = std::vector<double>());
+
+    size_t taille() const { return aeroports.size(); }
+    bool estVide() const { return aeroports.empty(); }
+    const Position& getAeroport(size_t i) const { return aeroports[i]; }
+    const TableDestinations& getTable(size_t origine) const { return tables[origine]; }
+
+    // Aéroport le plus proche à moins de TOLERANCE_ORIGINE, HORS_RESEAU sinon
+    int trouverOrigine(const Position& pos) const;
+
+    // Vrai si pos est à l'aéroport origine (HORS_RESEAU : jamais)
+    bool estA(int origine, const Position& pos) const {
+        return origine >= 0 && aeroports[origine].distanceTo(pos) <= TOLERANCE_ORIGINE;
+    }
+
+    // Tirage depuis un aéroport du réseau, en O(1)
+    size_t tirer(size_t origine, FluxAleatoire& flux) const {
+        return tables[origine].tirer(flux);
+    }
+
+    // Tirage depuis une position quelconque : mêmes règles que les tables,
+    // en deux passes sur le réseau (sans allocation)
+    size_t tirerDepuis(const Position& pos, FluxAleatoire& flux) const;
+};
+
+#endif // RESEAU_DESTINATIONS_H
@@ -0,0 +1,68 @@
+#ifndef SEQUENCE_ATTERRISSAGE_H
+#define SEQUENCE_ATTERRISSAGE_H
+
+#include "RegistreAvions.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Une urgence passe devant tout le trafic normal, quelle que soit son heure
+enum class PrioriteAtterrissage : std::uint8_t {
+    NORMALE = 0,
+    URGENCE = 1
+};
+
+struct CreneauAtterrissage {
+    IdAvion avion;
+    double heureEstimee;                // Atterrissage estimé (temps simulé, s)
+    PrioriteAtterrissage priorite;
+    std::uint64_t ordre;                // Ordre d'arrivée (départage les égalités)
+};
+
+// Séquence d'atterrissage d'un APP : tas binaire ordonné par priorité puis
+// par heure d'atterrissage estimée, doublé d'un index avion -> case du tas.
+// Appartenance en O(1) ; insertion, mise à jour de l'estimation,
+// changement de priorité et retrait d'un avion quelconque en O(log n).
+class SequenceAtterrissage {
+private:
+    std::vector<CreneauAtterrissage> tas;
+    std::unordered_map<IdAvion, size_t> index;     // Avion -> case dans tas
+    std::uint64_t prochainOrdre;
+
+    bool avant(const CreneauAtterrissage& a, const CreneauAtterrissage& b) const;
+    void echanger(size_t i, size_t j);
+    void monter(size_t i);
+    void descendre(size_t i);
+    void replacer(size_t i);
+
+public:
+    SequenceAtterrissage();
+
+    bool contient(IdAvion avion) const { return index.count(avion) != 0; }
+    size_t taille() const { return tas.size(); }
+    bool estVide() const { return tas.empty(); }
+
+    // Faux si l'avion est déjà dans la séquence
+    bool inserer(IdAvion avion, double heureEstimee,
+        PrioriteAtterrissage priorite = PrioriteAtterrissage::NORMALE);
+
+    // Nouvelle estimation ; faux si l'avion n'est pas dans la séquence
+    bool reordonner(IdAvion avion, double heureEstimee);
+
+    // Préemption : l'avion remonte (ou redescend) selon sa nouvelle priorité
+    bool prioriser(IdAvion avion, PrioriteAtterrissage priorite);
+
+    bool retirer(IdAvion avion);
+
+    // nullptr si l'avion n'est pas dans la séquence
+    const CreneauAtterrissage* trouver(IdAvion avion) const;
+
+    // Prochain avion à atterrir ; la séquence doit être non vide
+    const CreneauAtterrissage& premier() const { return tas.front(); }
+    IdAvion extrairePremier();
+
+    void vider();
+};
+
+#endif // SEQUENCE_ATTERRISSAGE_H
@@ -0,0 +1,62 @@
+#ifndef SONDE_CONFLITS_H
+#define SONDE_CONFLITS_H
+
+#include "Position.h"
+#include <vector>
+#include <cstddef>
+
+class Avion;
+
+// Trajectoire extrapolée en ligne droite à partir de l'état courant
+struct Trajectoire {
+    Avion* avion = nullptr;
+    Position depart;
+    double vx = 0.0;            // m/s
+    double vy = 0.0;
+    double vz = 0.0;            // Taux vertical (m/s)
+    double duree = 0.0;         // Durée de validité (s), bornée par l'arrivée à destination
+};
+
+// Conflit prévu entre deux trajectoires
+struct ConflitPrevu {
+    Avion* avion1 = nullptr;
+    Avion* avion2 = nullptr;
+    double tempsAvantConflit = 0.0;   // Perte de séparation dans t secondes
+    double tempsPointRapproche = 0.0; // Instant du point de rapprochement maximal (s)
+    double distanceMinimale = 0.0;    // Distance horizontale au point de rapprochement (m)
+};
+
+// Sonde de conflits à moyen terme : calcule le point de rapprochement
+// maximal (CPA) de chaque paire candidate sur un horizon donné.
+// Les paires candidates sont obtenues par des boîtes balayées rangées par
+// tranche de temps dans une grille, ce qui évite le parcours de toutes les paires.
+class SondeConflits {
+private:
+    double horizon;             // Horizon de prévision (s)
+    double separationH;         // Séparation horizontale minimale (m)
+    double separationV;         // Séparation verticale minimale (m)
+    double tailleCellule;       // Côté des cellules de la grille (m)
+
+public:
+    SondeConflits(double horizon = 1200.0, double separationH = 5000.0,
+        double separationV = 300.0, double tailleCellule = 20000.0);
+
+    void setHorizon(double h) { horizon = h; }
+    double getHorizon() const { return horizon; }
+
+    // Extrapole la trajectoire d'un avion en vol
+    static Trajectoire extrapoler(Avion* avion);
+
+    // Paires candidates (i < j) dont les boîtes balayées se chevauchent
+    std::vector<std::pair<size_t, size_t>> pairesCandidates(
+        const std::vector<Trajectoire>& trajectoires) const;
+
+    // Teste une paire ; renvoie vrai et remplit conflit si la séparation
+    // est perdue avant la fin de l'horizon
+    bool evaluer(const Trajectoire& a, const Trajectoire& b, ConflitPrevu& conflit) const;
+
+    // Conflits prévus, triés par temps avant conflit
+    std::vector<ConflitPrevu> sonder(const std::vector<Trajectoire>& trajectoires) const;
+};
+
+#endif // SONDE_CONFLITS_H
@@ -2,38 +2,36 @@
 #define TWR_H
 #include "../include/Position.h"
 #include "ControleurBase.h"
-#include <map>
+#include "EtatPiste.h"
+#include "AllocateurParkings.h"
+#include <vector>
 #include <chrono>
 #include <queue>
 
 struct Piste {
     bool occupee = false;
-    std::string avionActuel;
-    std::chrono::steady_clock::time_point heureLiberation;
+    IdAvion avionActuel = RegistreAvions::ID_INVALIDE;
+    double heureLiberation = 0.0;      // Temps simul (s)
     static constexpr int DUREE_ATTERRISSAGE = 5;  
 };
 
-struct Parking {
-    std::string id;
-    bool occupee = false;              
-    std::string avionActuel;
-    double distancePiste = 0.0;        
-    Position position;
-};
-
 class TWR : public ControleurBase {
 private:
     Piste piste;
-    std::map<std::string, Parking> parkings;
+    EtatPiste etatPiste;                    // Copie publie de piste, lue sans verrou
+    std::vector<ControleurBase*> abonnes;   // Notifis de chaque changement de piste
+    AllocateurParkings parkings;            // Parkings numrots, index avion -> parking
     std::queue<std::string> fileDecollage;
 
     void processLogic() override;
+    void avionDisparu(const Avion* avion, IdAvion id) override;
     void gererAtterrissages();
     void gererDecollages();
     void gererRoulage();
     bool pisteLibreInternal() const;
-    std::string assignerParking();
-    bool pisteOccupee;
+
+    // Publie l'tat de piste et le notifie aux abonns (mtx tenu)
+    void publierPiste();
 
 public:
     TWR(const std::string& nom);
@@ -41,7 +39,12 @@ public:
     // Initialisation des parkings
     void initialiserParkings(int nombre);
 
-    // Interface pour APP
+    // Interface pour APP : abonnement aux changements d'tat de piste
+    // (message PISTE_OCCUPEE ou PISTE_LIBEREE dans la bote de l'abonn,
+    // relev  son cycle suivant : au mme pas si la TWR tourne dans une
+    // vague antrieure)
+    void abonner(ControleurBase* abonne);
+    void desabonner(ControleurBase* abonne);
     bool pisteLibre() const;
     bool autoriserAtterrissage(const std::string& avionId);
 
@@ -52,11 +55,10 @@ public:
     std::string getParkingDisponible() const;
     void libererParking(const std::string& parkingId);
 
-    bool isPisteOccupee() const {
-        return pisteOccupee;  // Variable membre existante
-    }
-    void occuperPiste() { pisteOccupee = true; }
-    void libererPiste() { pisteOccupee = false; }
+    // tat de piste publi, lu sans verrou
+    InstantanePiste getEtatPiste() const { return etatPiste.lire(); }
+    std::uint64_t getSequencePiste() const { return etatPiste.getSequence(); }
+    bool isPisteOccupee() const { return etatPiste.lire().occupee; }
 };
 
 #endif // TWR_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef TABLE_TEXTES_H
+#define TABLE_TEXTES_H
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+typedef std::uint32_t IdTexte;
+
+// Table d'internement des textes courts et récurrents des messages : noms
+// de contrôleurs, d'aéroports, de parkings, actions... Un texte est copié une
+// seule fois ; ensuite les messages ne portent que son identifiant entier.
+// Les textes ne sont jamais libérés ni déplacés.
+class TableTextes {
+public:
+    static const IdTexte AUCUN = 0xFFFFFFFFu;
+
+private:
+    mutable std::mutex mtx;
+    std::unordered_map<std::string, IdTexte> ids;
+    std::deque<std::string> textes;         // Indexé par IdTexte, adresses stables
+
+    TableTextes(const TableTextes&);
+    TableTextes& operator=(const TableTextes&);
+
+public:
+    TableTextes() {}
+
+    // Table partagée par toute la simulation
+    static TableTextes& globale();
+
+    // Identifiant d'un texte (créé au premier appel)
+    IdTexte interner(const std::string& texte);
+
+    // Texte d'un identifiant ("" pour AUCUN)
+    const std::string& get(IdTexte id) const;
+
+    size_t taille() const;
+};
+
+#endif // TABLE_TEXTES_H
@@ -0,0 +1,154 @@
+#ifndef TRACE_BINAIRE_H
+#define TRACE_BINAIRE_H
+
+#include "Message.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// Enregistrement décodé d'une trace (textes et avions par identifiant)
+struct EnregistrementTrace {
+    TypeEvenement type = TypeEvenement::AUTRE;
+    std::uint16_t controleur = 0;
+    IdAvion avion1 = RegistreAvions::ID_INVALIDE;
+    IdAvion avion2 = RegistreAvions::ID_INVALIDE;
+    std::uint32_t texte1 = 0xFFFFFFFFu;
+    std::uint32_t texte2 = 0xFFFFFFFFu;
+    std::int64_t horodatage = 0;        // Millisecondes de temps simulé
+    double valeur1 = 0.0;
+    double valeur2 = 0.0;
+};
+
+// Format de trace binaire en colonnes, en ajout seul.
+//
+//   En-tête : "ATCTRACE", version, capacité des blocs
+//   Blocs de taille fixe : en-tête (nombre, horodatages min/max) puis une
+//     colonne par champ, chacune de capacité entrées
+//   À la fermeture : dictionnaires (contrôleurs, avions, textes), index des
+//     blocs (position, nombre, horodatages min/max) et pied de fichier.
+//
+// Les blocs étant de taille fixe, une trace interrompue sans pied de
+// fichier reste lisible (sans les noms).
+namespace FormatTrace {
+    const char MAGIQUE[8] = { 'A', 'T', 'C', 'T', 'R', 'A', 'C', 'E' };
+    const char MAGIQUE_FIN[8] = { 'F', 'I', 'N', 'T', 'R', 'A', 'C', 'E' };
+    const std::uint32_t VERSION = 1;
+    const std::uint32_t MAGIQUE_BLOC = 0x434F4C42;      // "BLOC"
+    const std::uint32_t TAILLE_EN_TETE = 16;
+    const std::uint32_t TAILLE_EN_TETE_BLOC = 24;
+
+    // Octets par enregistrement, toutes colonnes confondues
+    const std::uint32_t TAILLE_ENREGISTREMENT = 2 + 2 + 4 + 4 + 4 + 4 + 8 + 8 + 8;
+
+    inline std::uint64_t tailleBloc(std::uint32_t capacite) {
+        return TAILLE_EN_TETE_BLOC + static_cast<std::uint64_t>(capacite) * TAILLE_ENREGISTREMENT;
+    }
+}
+
+// Écriture d'une trace (partagée par tous les contrôleurs).
+// Chaque contrôleur accumule ses événements dans son propre tampon (textes
+// internés localement) ; le tampon n'est versé dans le bloc commun, sous le
+// verrou global, que par lots. L'ordre des événements d'un contrôleur est
+// conservé, même s'il change de thread d'un cycle à l'autre.
+class TraceBinaire {
+public:
+    struct EntreeIndex {
+        std::uint64_t position;
+        std::uint32_t nombre;
+        std::int64_t horodatageMin;
+        std::int64_t horodatageMax;
+    };
+
+    static const size_t TAILLE_LOT = 256;       // Événements versés d'un coup
+
+private:
+    struct Tampon;
+
+    std::ofstream fichier;
+    std::uint32_t capaciteBloc;
+    mutable std::mutex mtx;                     // Bloc en cours, dictionnaires, fichier
+    unsigned long identifiant;                  // Distingue les traces dans les caches des threads
+    std::atomic<bool> ouverte;
+
+    std::mutex mtxTampons;                      // Avant le verrou d'un tampon, lui-même avant mtx
+    std::vector<std::unique_ptr<Tampon>> tampons;  // Indexé par identifiant de contrôleur
+
+    // Bloc en cours, une colonne par champ
+    std::vector<std::uint16_t> colType;
+    std::vector<std::uint16_t> colControleur;
+    std::vector<std::uint32_t> colAvion1;
+    std::vector<std::uint32_t> colAvion2;
+    std::vector<std::uint32_t> colTexte1;
+    std::vector<std::uint32_t> colTexte2;
+    std::vector<std::int64_t> colHorodatage;
+    std::vector<double> colValeur1;
+    std::vector<double> colValeur2;
+
+    std::vector<EntreeIndex> index;
+    std::vector<std::string> nomsControleurs;   // Indexé par identifiant de contrôleur
+    std::unordered_map<std::string, std::uint32_t> idsTextes;
+    std::vector<std::string> textes;
+    IdAvion idAvionMax;                         // Plus grand identifiant d'avion rencontré
+    unsigned long long nbEnregistrements;
+
+    std::uint32_t internerTexte(const std::string* texte);
+    void ecrireBloc();
+    Tampon& tamponDe(size_t controleur, const std::string& nomControleur);
+    void verser(Tampon& tampon);                // Tampon verrouillé par l'appelant
+
+    TraceBinaire(const TraceBinaire&);
+    TraceBinaire& operator=(const TraceBinaire&);
+
+public:
+    explicit TraceBinaire(const std::string& chemin, std::uint32_t capaciteBloc = 4096);
+    ~TraceBinaire();
+
+    bool estOuverte() const { return fichier.is_open(); }
+
+    void ajouter(const EvenementTrace& evenement, int idControleur,
+        const std::string& nomControleur, std::int64_t horodatage);
+
+    // Verse les tampons, écrit le dernier bloc, les dictionnaires et l'index.
+    // Les événements ajoutés pendant ou après la fermeture sont ignorés.
+    void fermer();
+
+    // Événements versés dans les blocs (tous, une fois la trace fermée)
+    unsigned long long getNbEnregistrements() const;
+};
+
+// Lecture d'une trace
+class LecteurTrace {
+private:
+    std::ifstream fichier;
+    std::uint32_t capaciteBloc;
+    std::vector<TraceBinaire::EntreeIndex> index;
+    std::vector<std::string> nomsControleurs;
+    std::vector<std::string> nomsAvions;
+    std::vector<std::string> textes;
+    bool complete;                      // Pied de fichier présent
+
+public:
+    LecteurTrace();
+
+    bool ouvrir(const std::string& chemin);
+
+    bool estComplete() const { return complete; }
+    size_t getNbBlocs() const { return index.size(); }
+    const TraceBinaire::EntreeIndex& getEntreeIndex(size_t bloc) const { return index[bloc]; }
+
+    // Décode un bloc entier
+    bool lireBloc(size_t bloc, std::vector<EnregistrementTrace>& enregistrements);
+
+    // Noms (ou "#identifiant" si absent des dictionnaires)
+    std::string nomControleur(std::uint16_t id) const;
+    std::string nomAvion(IdAvion id) const;
+    std::string texte(std::uint32_t id) const;
+};
+
+#endif // TRACE_BINAIRE_H
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -14,15 +15,41 @@ APP::APP(const std::string& nom, const Position& centre, float rayon,
     : ControleurBase(nom),
     centreAeroport(centre),
     rayonControle(rayon),
-    towerReference(twr),
-    ccrReference(ccr) {
+    compteurCycles(0),
+    towerReference(nullptr),
+    ccrReference(nullptr) {
+    setTWR(twr);
+    setCCR(ccr);
+}
+
+APP::~APP() {
+    // Plus de notification vers un APP détruit
+    if (towerReference != nullptr) {
+        towerReference->desabonner(this);
+    }
+}
+
+void APP::setTWR(TWR* twr) {
+    if (towerReference != nullptr) {
+        towerReference->desabonner(this);
+    }
+    towerReference = twr;
+    if (twr != nullptr) {
+        twr->abonner(this);
+    }
+}
+
+void APP::setCCR(CCR* ccr) {
+    ccrReference = ccr;
+    if (ccr != nullptr) {
+        relier(*this, *ccr);
+    }
 }
 
 void APP::processLogic() {
     std::lock_guard<std::mutex> lock(mtx);
 
-    static int compteur = 0;
-    if (compteur++ % 50 == 0) {
+    if (compteurCycles++ % 50 == 0) {
         if (!avionsSousControle.empty()) {
             std::cout << "[APP " << nom << "] " << avionsSousControle.size() << " avions\n";
             for (auto* avion : avionsSousControle) {
@@ -32,7 +59,9 @@ void APP::processLogic() {
         }
     }
 
+    actualiserPiste();
     gererNouvellesArrivees();
+    gererUrgences();
     gererTrajectoires();
     gererDeparts();
 }
@@ -50,95 +79,192 @@ void APP::ajouterAvionEnApproche(Avion* avion) {
     if (avion == nullptr) return;
 
     // Vérifier si l'avion n'est pas déjà dans la liste
-    for (auto* a : avionsEnApproche) {
-        if (a->getNom() == avion->getNom()) {
-            return;
-        }
+    if (!idsEnApproche.insert(avion->getId()).second) {
+        return;
     }
 
     avionsEnApproche.push_back(avion);
     ajouterAvion(avion);
 
-    logAction("AVION_AJOUTE", "Avion " + avion->getNom() + " ajouté en approche");
+    EvenementTrace e(TypeEvenement::AVION_AJOUTE);
+    e.avion1 = avion->getId();
+    logEvenement(e);
 }
 
 void APP::retirerAvionEnApproche(Avion* avion) {
     if (avion == nullptr) return;
 
+    if (idsEnApproche.erase(avion->getId()) == 0) {
+        return;
+    }
+
     for (size_t i = 0; i < avionsEnApproche.size(); i++) {
-        if (avionsEnApproche[i]->getNom() == avion->getNom()) {
+        if (avionsEnApproche[i]->getId() == avion->getId()) {
             avionsEnApproche.erase(avionsEnApproche.begin() + i);
-            retirerAvion(avion->getNom());
-            logAction("AVION_RETIRE", "Avion " + avion->getNom() + " retiré de l'approche");
-            return;
+            break;
         }
     }
+
+    sequenceAtterrissage.retirer(avion->getId());
+    retirerAvion(avion);
+    EvenementTrace e(TypeEvenement::AVION_RETIRE);
+    e.avion1 = avion->getId();
+    logEvenement(e);
+}
+
+void APP::avionDisparu(const Avion* avion, IdAvion id) {
+    sequenceAtterrissage.retirer(id);
+    if (idsEnApproche.erase(id) == 0) return;
+
+    auto it = std::find(avionsEnApproche.begin(), avionsEnApproche.end(), avion);
+    if (it != avionsEnApproche.end()) {
+        avionsEnApproche.erase(it);
+    }
 }
 
 void APP::gererNouvellesArrivees() {
     for (auto* avion : avionsSousControle) {
-   
-        if (avion->getEtat() == EtatAvion::DESCENTE) {  
-            Position pos = avion->getPosition();
+        // Instantané antérieur à notre dernière décision : l'avion est peut-être
+        // déjà en approche
+        if (!etatAJour(avion)) continue;
+
+        EtatPublie publie = etatPublie(avion);
+        if (publie.getEtat() == EtatAvion::DESCENTE) {
+            Position pos = publie.getPosition();
 
             if (estDansZone(pos)) {
-                avion->setEtat(EtatAvion::APPROCHE);
-
-                // Vérifier si l'avion n'est pas déjà dans la file
-                bool dejaDansFile = false;
-                std::queue<std::string> tempQueue = fileAttenteAtterrissage;
-                while (!tempQueue.empty()) {
-                    if (tempQueue.front() == avion->getNom()) {
-                        dejaDansFile = true;
-                        break;
-                    }
-                    tempQueue.pop();
-                }
+                appliquerEtat(avion, EtatAvion::APPROCHE);
 
-                if (!dejaDansFile) {
-                    fileAttenteAtterrissage.push(avion->getNom());
+                // Déjà séquencé : seule l'estimation change
+                double heure = estimerAtterrissage(publie);
+                if (!sequenceAtterrissage.inserer(avion->getId(), heure)) {
+                    sequenceAtterrissage.reordonner(avion->getId(), heure);
                 }
 
-                int niveau = static_cast<int>(fileAttenteAtterrissage.size());
+                int niveau = static_cast<int>(sequenceAtterrissage.taille());
                 assignerTrajectoireCirculaire(avion, niveau);
 
-                logAction("ENTREE_ZONE_APPROCHE",
-                    "Avion " + avion->getNom() + " entre en zone d'approche, niveau " +
-                    std::to_string(niveau));
+                EvenementTrace e(TypeEvenement::ENTREE_ZONE_APPROCHE);
+                e.avion1 = avion->getId();
+                e.valeur1 = niveau;
+                logEvenement(e);
+            }
+        }
+    }
+}
+
+double APP::estimerAtterrissage(const EtatPublie& publie) const {
+    double distance = publie.getPosition().distanceTo(centreAeroport);
+    double vitesse = publie.vitesse > 1.0 ? publie.vitesse : 1.0;
+    return horloge->maintenant() + distance / vitesse;
+}
+
+void APP::declarerUrgence(IdAvion avion) {
+    std::lock_guard<std::mutex> lock(mtx);
+    urgencesDeclarees.push_back(avion);
+}
+
+void APP::gererUrgences() {
+    for (IdAvion id : urgencesDeclarees) {
+        if (!sequenceAtterrissage.prioriser(id, PrioriteAtterrissage::URGENCE)) {
+            // Pas encore séquencé : entre directement en tête s'il est ici
+            Avion* avion = nullptr;
+            for (auto* a : avionsSousControle) {
+                if (a != nullptr && a->getId() == id) {
+                    avion = a;
+                    break;
+                }
             }
+            if (avion == nullptr) continue;
+
+            sequenceAtterrissage.inserer(id, estimerAtterrissage(etatPublie(avion)),
+                PrioriteAtterrissage::URGENCE);
         }
+
+        EvenementTrace e(TypeEvenement::URGENCE_PRIORISEE);
+        e.avion1 = id;
+        e.valeur1 = static_cast<double>(sequenceAtterrissage.taille());
+        logEvenement(e);
+    }
+    urgencesDeclarees.clear();
+}
+
+void APP::actualiserPiste() {
+    if (towerReference == nullptr) return;
+
+    // La TWR tourne dans une vague antérieure : ses changements du pas en
+    // cours sont déjà dans les messages relevés. La plus récente fait foi.
+    const int idTour = towerReference->getIdControleur();
+    for (const auto& msg : tamponReleve) {
+        if (msg.expediteur != idTour) continue;
+        if (msg.type != TypeEvenement::PISTE_OCCUPEE && msg.type != TypeEvenement::PISTE_LIBEREE) continue;
+
+        std::uint64_t sequence = static_cast<std::uint64_t>(msg.charge.evenement.valeur2);
+        if (sequence <= pisteConnue.sequence) continue;
+
+        pisteConnue.sequence = sequence;
+        pisteConnue.occupee = msg.type == TypeEvenement::PISTE_OCCUPEE;
+        pisteConnue.avion = msg.charge.evenement.avion1;
+        pisteConnue.heureLiberation = msg.charge.evenement.valeur1;
+    }
+
+    // Notification refusée (boîte pleine) : une seule lecture sans verrou
+    // de l'état publié
+    if (towerReference->getSequencePiste() != pisteConnue.sequence) {
+        pisteConnue = towerReference->getEtatPiste();
     }
 }
 
 void APP::gererTrajectoires() {
+    // Piste libre dès l'heure de libération publiée, sans attendre que la
+    // TWR la constate à son cycle : les avions en attente partent à l'heure
+    bool pisteOccupee = pisteConnue.occupee &&
+        horloge->maintenant() < pisteConnue.heureLiberation;
+
+    // Séquence tenue à jour avant toute décision : nouvelle estimation en
+    // approche, retrait une fois l'avion posé ; un avion en attente encore
+    // hors séquence y entre, sinon il ne serait jamais autorisé
     for (auto* avion : avionsSousControle) {
-        if (avion == nullptr) continue;
+        if (avion == nullptr || !etatAJour(avion)) continue;
 
-        EtatAvion etat = avion->getEtat();
+        EtatPublie publie = etatPublie(avion);
+        EtatAvion etat = publie.getEtat();
 
-        if (etat == EtatAvion::ATTERRISSAGE) {
-            bool pisteOccupee = false;
-
-            if (towerReference != nullptr) {
-                pisteOccupee = towerReference->isPisteOccupee();  // ← Utilise piste.occupee
+        if (sequenceAtterrissage.contient(avion->getId())) {
+            if (etat == EtatAvion::APPROCHE || etat == EtatAvion::ATTENTE ||
+                etat == EtatAvion::ATTERRISSAGE) {
+                sequenceAtterrissage.reordonner(avion->getId(), estimerAtterrissage(publie));
+            }
+            else if (etat != EtatAvion::DESCENTE) {
+                sequenceAtterrissage.retirer(avion->getId());
             }
+        }
+        else if (etat == EtatAvion::ATTENTE) {
+            sequenceAtterrissage.inserer(avion->getId(), estimerAtterrissage(publie));
+        }
+    }
+
+    // Piste libre : seul le premier de la séquence (une urgence passe
+    // devant) quitte l'attente, les autres attendent qu'il se soit posé
+    IdAvion suivant = sequenceAtterrissage.estVide()
+        ? RegistreAvions::ID_INVALIDE : sequenceAtterrissage.premier().avion;
+
+    for (auto* avion : avionsSousControle) {
+        if (avion == nullptr || !etatAJour(avion)) continue;
 
+        EtatAvion etat = etatPublie(avion).getEtat();
+
+        if (etat == EtatAvion::ATTERRISSAGE) {
             if (pisteOccupee) {
-                avion->setEtat(EtatAvion::ATTENTE);
+                appliquerEtat(avion, EtatAvion::ATTENTE);
                 avion->setCentreAttente(centreAeroport);
                 std::cout << "[" << avion->getNom() << "] Piste occupée - Mise en attente\n";
             }
         }
 
         if (etat == EtatAvion::ATTENTE) {
-            bool pisteOccupee = false;
-
-            if (towerReference != nullptr) {
-                pisteOccupee = towerReference->isPisteOccupee();
-            }
-
-            if (!pisteOccupee) {
-                avion->setEtat(EtatAvion::ATTERRISSAGE);
+            if (!pisteOccupee && avion->getId() == suivant) {
+                appliquerEtat(avion, EtatAvion::ATTERRISSAGE);
                 std::cout << "[" << avion->getNom() << "] Piste libre - Autorisation d'atterrir\n";
             }
         }
@@ -160,10 +286,11 @@ void APP::assignerTrajectoireCirculaire(Avion* avion, int niveau) {
     double rayonTrajectoire = rayonControle * 0.8 - (niveau * 1000.0);
     double altitude = 1000.0 + (niveau * 500.0);
 
-    logAction("TRAJECTOIRE_ASSIGNEE",
-        "Avion " + avion->getNom() + " - Trajectoire circulaire rayon " +
-        std::to_string(static_cast<int>(rayonTrajectoire)) + "m, altitude " +
-        std::to_string(static_cast<int>(altitude)) + "m");
+    EvenementTrace e(TypeEvenement::TRAJECTOIRE_ASSIGNEE);
+    e.avion1 = avion->getId();
+    e.valeur1 = rayonTrajectoire;
+    e.valeur2 = altitude;
+    logEvenement(e);
 }
 
 void APP::gererDeparts() {
@@ -172,8 +299,9 @@ void APP::gererDeparts() {
     for (auto* avion : avionsSousControle) {
         if (avion == nullptr) continue;
 
-        EtatAvion etat = avion->getEtat();
-        Position pos = avion->getPosition();
+        EtatPublie publie = etatPublie(avion);
+        EtatAvion etat = publie.getEtat();
+        Position pos = publie.getPosition();
 
         // Si l'avion est en CROISIERE et loin (> 55 km)
         if (etat == EtatAvion::CROISIERE) {
@@ -184,24 +312,23 @@ void APP::gererDeparts() {
         }
     }
 
-    // Retirer les avions de l'APP ET les redonner au CCR
+    // Offrir les avions au CCR, qui les accepte à son cycle (la propriété
+    // passe alors au CCR dans le registre) ; canal plein : nouvelle offre
+    // au cycle suivant
     for (auto* avion : avionsARetirer) {
-        auto it = std::find(avionsSousControle.begin(), avionsSousControle.end(), avion);
-        if (it != avionsSousControle.end()) {
-            avionsSousControle.erase(it);
-
-            // ✅ REDONNER L'AVION AU CCR
-            if (ccrReference != nullptr) {
-                ccrReference->ajouterAvion(avion);
-            }
+        if (ccrReference != nullptr) {
+            offrirAvion(avion, ccrReference);
+        }
+        else if (oublierAvion(avion)) {
+            RegistreAvions::globale().liberer(avion->getId(), idControleur);
         }
     }
 }
 
 APP* APP::demanderNouvelAPP() {
     if (ccrReference != nullptr) {
-        logAction("DEMANDE_NOUVEL_APP",
-            "Zone saturée, demande d'un nouveau contrôleur d'approche");
+        EvenementTrace e(TypeEvenement::DEMANDE_NOUVEL_APP);
+        logEvenement(e);
         return nullptr;
     }
     return nullptr;
@@ -214,7 +341,11 @@ void APP::afficherConsole() const {
     std::cout << "Zone de controle: " << static_cast<int>(rayonControle / 1000.0) << " km\n";
     std::cout << "Centre: (" << centreAeroport.x << ", " << centreAeroport.y << ")\n";
     std::cout << "Avions sous controle: " << avionsSousControle.size() << "\n";
-    std::cout << "File d'attente: " << fileAttenteAtterrissage.size() << "\n";
+    std::cout << "Sequence d'atterrissage: " << sequenceAtterrissage.taille() << "\n";
+    if (!sequenceAtterrissage.estVide()) {
+        std::cout << "Prochain a atterrir: "
+            << RegistreAvions::globale().getNom(sequenceAtterrissage.premier().avion) << "\n";
+    }
 
     if (!avionsSousControle.empty()) {
         std::cout << "\n--- AVIONS EN APPROCHE ---\n";
@@ -244,23 +375,3 @@ void APP::afficherConsole() const {
     }
     std::cout << "=====================================\n";
 }
-
-void APP::transfererAvionVersCCR(Avion* avion) {
-    if (avion == nullptr || ccrReference == nullptr) {
-        return;
-    }
-
-    std::lock_guard<std::mutex> lock(mtx);
-
-    // Vérifier que l'avion est bien en dehors de notre zone
-    if (!estDansZone(avion->getPosition())) {
-        logAction("TRANSFERT_CCR",
-            "Avion " + avion->getNom() + " transféré au CCR");
-
-        // Notifier le CCR
-        ccrReference->recevoirAvionDepuisAPP(avion, nom);
-
-        // Retirer l'avion de notre contrôle
-        retirerAvion(avion->getNom());
-    }
-}
\ No newline at end of file
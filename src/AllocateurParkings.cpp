@@ -0,0 +1,118 @@
+#include "../include/AllocateurParkings.h"
+
+namespace {
+
+    inline unsigned premierBit(std::uint64_t mot) {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(mot));
+#else
+        unsigned n = 0;
+        while ((mot & 1u) == 0) {
+            mot >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+
+} // namespace
+
+AllocateurParkings::AllocateurParkings() : nbLibres(0) {
+}
+
+void AllocateurParkings::marquerLibre(int numero) {
+    size_t mot = static_cast<size_t>(numero) / 64;
+    libres[mot] |= std::uint64_t(1) << (numero % 64);
+    resume[mot / 64] |= std::uint64_t(1) << (mot % 64);
+    nbLibres++;
+}
+
+void AllocateurParkings::marquerOccupe(int numero) {
+    size_t mot = static_cast<size_t>(numero) / 64;
+    libres[mot] &= ~(std::uint64_t(1) << (numero % 64));
+    if (libres[mot] == 0) {
+        resume[mot / 64] &= ~(std::uint64_t(1) << (mot % 64));
+    }
+    nbLibres--;
+}
+
+int AllocateurParkings::ajouter(const std::string& nom, double distancePiste, const Position& position) {
+    auto it = numeroParNom.find(nom);
+    if (it != numeroParNom.end()) {
+        parkings[it->second].distancePiste = distancePiste;
+        parkings[it->second].position = position;
+        return it->second;
+    }
+
+    int numero = static_cast<int>(parkings.size());
+    Parking p;
+    p.id = nom;
+    p.distancePiste = distancePiste;
+    p.position = position;
+    parkings.push_back(p);
+    numeroParNom[nom] = numero;
+
+    if (libres.size() * 64 < parkings.size()) libres.push_back(0);
+    if (resume.size() * 64 < libres.size()) resume.push_back(0);
+    marquerLibre(numero);
+    return numero;
+}
+
+int AllocateurParkings::trouver(const std::string& nom) const {
+    auto it = numeroParNom.find(nom);
+    return it == numeroParNom.end() ? AUCUN : it->second;
+}
+
+int AllocateurParkings::premierLibre() const {
+    // Un mot de résumé couvre 4096 parkings : en pratique une seule itération
+    for (size_t r = 0; r < resume.size(); r++) {
+        if (resume[r] == 0) continue;
+        size_t mot = r * 64 + premierBit(resume[r]);
+        return static_cast<int>(mot * 64 + premierBit(libres[mot]));
+    }
+    return AUCUN;
+}
+
+bool AllocateurParkings::occuper(int numero, IdAvion avion) {
+    Parking& p = parkings[numero];
+    if (p.occupee) return false;
+
+    // Un avion n'occupe qu'un parking à la fois
+    libererAvion(avion);
+
+    p.occupee = true;
+    p.avionActuel = avion;
+    parkingParAvion[avion] = numero;
+    marquerOccupe(numero);
+    return true;
+}
+
+int AllocateurParkings::allouer(IdAvion avion) {
+    int numero = premierLibre();
+    if (numero != AUCUN) {
+        occuper(numero, avion);
+    }
+    return numero;
+}
+
+bool AllocateurParkings::liberer(int numero) {
+    Parking& p = parkings[numero];
+    if (!p.occupee) return false;
+
+    auto it = parkingParAvion.find(p.avionActuel);
+    if (it != parkingParAvion.end() && it->second == numero) {
+        parkingParAvion.erase(it);
+    }
+    p.occupee = false;
+    p.avionActuel = RegistreAvions::ID_INVALIDE;
+    marquerLibre(numero);
+    return true;
+}
+
+int AllocateurParkings::libererAvion(IdAvion avion) {
+    int numero = parkingDe(avion);
+    if (numero != AUCUN) {
+        liberer(numero);
+    }
+    return numero;
+}
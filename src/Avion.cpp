@@ -1,66 +1,51 @@
 ﻿
 #include "../include/Avion.h"
 #include <cmath>
-#include <chrono>
-#include <thread>
 #include <iostream>
-#include <random>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-std::chrono::steady_clock::time_point Avion::tempsDebutSimulation;
-bool Avion::simulationDemarree = false;
+Horloge* Avion::horloge = &Horloge::systeme();
+std::uint64_t Avion::graineScenario = 0;
 
 Avion::Avion(const std::string& nom, const Position& pos_depart,
-    const std::vector<Position>& destinations)
+    const std::vector<Position>& destinations, Flotte& flotte)
     : nom(nom),
-    position(pos_depart),
-    positionDepart(pos_depart),
-    destinationsPossibles(destinations),
-    vitesse(0.0),
-    cap(0.0),
-    altitude_cible(10000.0),
-    etat(EtatAvion::PARKING),
-    enRoute(false),
+    id(RegistreAvions::globale().acquerir(nom)),
+    flotte(flotte),
+    indice(flotte.enregistrer(this)),
+    tempsParkingDebut(0.0),
     tempsRoulageDebut(0.0),
+    fluxDestinations(graineScenario, FluxAleatoire::sujet(nom), FluxAleatoire::DESTINATIONS),
+    fluxParking(graineScenario, FluxAleatoire::sujet(nom), FluxAleatoire::PARKING),
+    reseau(ReseauDestinations::partager(destinations)),
+    destinationReseau(ReseauDestinations::HORS_RESEAU),
+    positionDepart(pos_depart),
+    pointDecollage(pos_depart),
     nombreVols(0),
     premierVol(true),
+    volUnique(false),
+    termine(false),
     enParking(false),
     tempsAttenteParking(5) {
 
-    // ✅ UTILISER LA MÊME LOGIQUE que choisirNouvelleDestination()
-    if (!destinationsPossibles.empty()) {
-        // Créer une liste de destinations DIFFÉRENTES de la position de départ
-        std::vector<Position> destinationsValides;
-        for (const auto& dest : destinationsPossibles) {
-            double distance = pos_depart.distanceTo(dest);
-            if (distance > 50000.0) {  // > 50 km
-                destinationsValides.push_back(dest);
-            }
-        }
-
-        // Choisir aléatoirement parmi les destinations valides
-        if (!destinationsValides.empty()) {
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(0, destinationsValides.size() - 1);
-            destination = destinationsValides[dis(gen)];
-        }
-        else {
-            // Fallback : choisir la destination la plus éloignée
-            double maxDistance = 0.0;
-            for (const auto& dest : destinationsPossibles) {
-                double distance = pos_depart.distanceTo(dest);
-                if (distance > maxDistance) {
-                    maxDistance = distance;
-                    destination = dest;
-                }
-            }
-        }
+    setPosition(pos_depart);
+    flotte.altitudeCible[indice] = 10000.0;
 
-        cap = calculerCap(destination);
+    // ✅ UTILISER LA MÊME LOGIQUE que choisirNouvelleDestination()
+    if (!reseau->estVide()) {
+        // Destination à plus de 50 km du départ (à défaut la plus éloignée)
+        int origine = reseau->trouverOrigine(pos_depart);
+        size_t choix = origine != ReseauDestinations::HORS_RESEAU
+            ? reseau->tirer(origine, fluxDestinations)
+            : reseau->tirerDepuis(pos_depart, fluxDestinations);
+        destinationReseau = static_cast<int>(choix);
+
+        const Position& destination = reseau->getAeroport(choix);
+        setDestination(destination);
+        setCap(calculerCap(destination));
 
         std::cout << "[" << nom << "] Destination initiale: "
             << "(" << (int)(destination.x / 1000) << ", "
@@ -68,85 +53,44 @@ Avion::Avion(const std::string& nom, const Position& pos_depart,
     }
 
     // Paramètres de vol
-    vitesse_croisiere = 250.0;
-    vitesse_montee = 50.0;
-    vitesse_descente = 40.0;
+    flotte.vitesseCroisiere[indice] = 250.0;
+    flotte.vitesseMontee[indice] = 50.0;
+    flotte.vitesseDescente[indice] = 40.0;
     vitesse_roulage = 5.0;
 }
 
+Avion::~Avion() {
+    RegistreAvions::globale().attribuer(id, RegistreAvions::AUCUN_CONTROLEUR);
+    flotte.retirer(indice);
+    RegistreAvions::globale().relacher(id);
+}
 
 
-void Avion::demarrer() {
-    enRoute = true;
-
-    auto dernierTemps = std::chrono::steady_clock::now();
-
-    while (enRoute) {
-        // Calculer le delta temps
-        auto maintenant = std::chrono::steady_clock::now();
-        auto duree = std::chrono::duration_cast<std::chrono::milliseconds>(maintenant - dernierTemps);
-        double dt = duree.count() / 1000.0;  // Convertir en secondes
-        dernierTemps = maintenant;
-
-        // Mettre à jour l'avion
-        if (dt > 0.0 && dt < 1.0) {  // Limiter dt pour éviter les sauts
-            update(dt*3.0);
-        }
-
-        // Petite pause pour ne pas surcharger le CPU (60 FPS)
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
-    }
-}
 
 void Avion::choisirNouvelleDestination() {
-    if (destinationsPossibles.empty()) {
+    if (reseau->estVide()) {
         std::cerr << "[" << nom << "] ERREUR: Aucune destination disponible\n";
         return;
     }
 
-    if (destinationsPossibles.size() == 1) {
-        destination = destinationsPossibles[0];
-        cap = calculerCap(destination);
-        std::cout << "[" << nom << "] Nouvelle destination choisie: "
-            << "(" << (int)(destination.x / 1000) << ", "
-            << (int)(destination.y / 1000) << ") km\n";
-        return;
-    }
-
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-
-    std::vector<Position> destinationsValides;
-
-    
-    for (const auto& dest : destinationsPossibles) {
-        double distance = position.distanceTo(dest);
-        if (distance > 50000.0) {
-            destinationsValides.push_back(dest);
+    size_t choix = 0;
+    if (reseau->taille() > 1) {
+        // L'avion repart normalement de l'aéroport où il vient de se poser :
+        // table précalculée, aucune allocation
+        Position position = getPosition();
+        int origine = destinationReseau;
+        if (!reseau->estA(origine, position)) {
+            origine = reseau->trouverOrigine(position);
         }
+        choix = origine != ReseauDestinations::HORS_RESEAU
+            ? reseau->tirer(origine, fluxDestinations)
+            : reseau->tirerDepuis(position, fluxDestinations);
     }
+    destinationReseau = static_cast<int>(choix);
 
-    if (destinationsValides.empty()) {
-      
-        double maxDistance = 0.0;
-        Position destinationLaPlusLoin;
-
-        for (const auto& dest : destinationsPossibles) {
-            double distance = position.distanceTo(dest);
-            if (distance > maxDistance) {
-                maxDistance = distance;
-                destinationLaPlusLoin = dest;
-            }
-        }
-
-        destination = destinationLaPlusLoin;
-    }
-    else {
-        std::uniform_int_distribution<> dis(0, destinationsValides.size() - 1);
-        destination = destinationsValides[dis(gen)];
-    }
-
-    cap = calculerCap(destination);
+    const Position& destination = reseau->getAeroport(choix);
+    setDestination(destination);
+    setCap(calculerCap(destination));
 
     std::cout << "[" << nom << "] Nouvelle destination choisie: "
         << "(" << (int)(destination.x / 1000) << ", "
@@ -154,7 +98,22 @@ void Avion::choisirNouvelleDestination() {
 }
 
 void Avion::update(double dt) {
-    switch (etat) {
+    EtatAvion etat = getEtat();
+    if (Flotte::estCinematique(etat)) {
+        flotte.avancer(etat, indice, indice + 1, dt, horloge->maintenant() + dt);
+    }
+
+    finaliserPas(dt);
+}
+
+void Avion::finaliserPas(double dt) {
+    // Un noyau a détecté un changement d'état pendant ce pas
+    if (flotte.transition[indice] != 0) {
+        appliquerTransition(horloge->maintenant() + dt);
+        return;
+    }
+
+    switch (getEtat()) {
     case EtatAvion::PARKING:
         updateParking(dt);  
         break;
@@ -163,46 +122,106 @@ void Avion::update(double dt) {
         updateRoulageDecollage(dt);
         break;
 
-    case EtatAvion::DECOLLAGE:
-        updateDecollage(dt);
+    case EtatAvion::ATTENTE:      
+        updateAttente(dt);
         break;
 
-    case EtatAvion::MONTEE:
-        updateMontee(dt);
+    case EtatAvion::ROULAGE_ARRIVEE:
+        updateRoulageArrivee(dt);
         break;
 
-    case EtatAvion::CROISIERE:
-        updateCroisiere(dt);
+    default:
         break;
+    }
+}
 
-    case EtatAvion::DESCENTE:
-        updateDescente(dt);
-        break;
+bool Avion::calculerReveil(double& temps) const {
+    if (flotte.transition[indice] != 0) return false;
 
-    case EtatAvion::APPROCHE:
-        updateApproche(dt);
-        break;
+    switch (getEtat()) {
+    case EtatAvion::PARKING:
+        if (!enParking) return false;
+        temps = tempsParkingDebut + tempsAttenteParking;
+        return true;
 
-    case EtatAvion::ATTENTE:      
-        updateAttente(dt);
-        break;
+    case EtatAvion::CROISIERE:
+        temps = flotte.finCroisiere[indice];
+        return true;
 
-    case EtatAvion::ATTERRISSAGE:
-        updateAtterrissage(dt);
-        break;
+    default:
+        return false;
+    }
+}
 
-    case EtatAvion::ROULAGE_ARRIVEE:
-        updateRoulageArrivee(dt);
-        break;
+void Avion::changerEtat(EtatAvion nouvelEtat, double temps) {
+    EtatAvion ancien = getEtat();
+    if (ancien != nouvelEtat) {  // Afficher seulement si changement réel
+        std::cout << "[" << nom << "] " << getEtatString()
+            << " -> " << getEtatStringFromEnum(nouvelEtat) << "\n";
+    }
+    flotte.etat[indice] = static_cast<std::uint8_t>(nouvelEtat);
+
+    if (nouvelEtat == EtatAvion::CROISIERE && ancien != EtatAvion::CROISIERE) {
+        entrerCroisiere(temps);
+    }
+}
+
+void Avion::entrerCroisiere(double temps) {
+    // Plan de vol : position actuelle, points de passage de la route
+    // déclarée au CCR encore devant l'avion, puis destination
+    Position ici(flotte.x[indice], flotte.y[indice], flotte.altitude[indice]);
+    Position destination = getDestination();
+
+    std::vector<Position> points;
+    points.push_back(ici);
+
+    // Route partagée, lue sans copie ni verrou
+    std::shared_ptr<const RouteDeclaree> route = ReseauRoutes::globale().trouver(pointDecollage, destination);
+    if (route) {
+        double vx = destination.x - ici.x;
+        double vy = destination.y - ici.y;
+        for (size_t k = 1; k + 1 < route->points.size(); k++) {
+            double px = route->points[k].x - ici.x;
+            double py = route->points[k].y - ici.y;
+            if (px * vx + py * vy > 0.0) {
+                points.push_back(route->points[k]);
+            }
+        }
+    }
+    points.push_back(destination);
+
+    // Plan immuable, partagé avec les instantanés publiés
+    flotte.demarrerCroisiere(indice, std::make_shared<PlanVol>(points), temps);
+}
+
+void Avion::appliquerTransition(double temps) {
+    EtatAvion ancien = getEtat();
+    EtatAvion nouvel = static_cast<EtatAvion>(flotte.transition[indice] - 1);
+    flotte.transition[indice] = 0;
+
+    changerEtat(nouvel, temps);
+
+    if (nouvel == EtatAvion::PARKING &&
+        (ancien == EtatAvion::DESCENTE || ancien == EtatAvion::APPROCHE ||
+            ancien == EtatAvion::ATTERRISSAGE)) {
+        std::cout << "[" << nom << "]  Atterri et stationne\n";
     }
 }
 
 void Avion::updateParking(double dt) {
     
-    vitesse = 0.0;
+    flotte.vitesse[indice] = 0.0;
     
+    if (volUnique) {
+        if (!termine) {
+            termine = true;
+            std::cout << "[" << nom << "] Vol termine - avion retire\n";
+        }
+        return;
+    }
+
     if (!enParking) {
-        tempsParkingDebut = std::chrono::steady_clock::now();
+        tempsParkingDebut = horloge->maintenant();
         enParking = true;
         
         if (premierVol) {
@@ -210,20 +229,15 @@ void Avion::updateParking(double dt) {
             premierVol = false;
             std::cout << "[" << nom << "] Premier vol - Attente 5 secondes...\n";
         } else {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(10, 20);
-            tempsAttenteParking = dis(gen);
+            tempsAttenteParking = fluxParking.entier(10, 20);
             std::cout << "[" << nom << "] Attente " << tempsAttenteParking 
                       << " secondes avant redecollage...\n";
         }
     }
     
-    auto maintenant = std::chrono::steady_clock::now();
-    auto duree = std::chrono::duration_cast<std::chrono::seconds>(
-        maintenant - tempsParkingDebut);
+    double duree = horloge->maintenant() - tempsParkingDebut;
     
-    if (duree.count() >= tempsAttenteParking) {
+    if (duree >= tempsAttenteParking) {
         nombreVols++;
         
         if (nombreVols > 1) {
@@ -233,22 +247,23 @@ void Avion::updateParking(double dt) {
         std::cout << "[" << nom << "] Decollage numero " << nombreVols << "\n";
         
         
-        vitesse = 0.0;
-        position.altitude = 0.0;
-        altitude_cible = 10000.0;
+        flotte.vitesse[indice] = 0.0;
+        flotte.altitude[indice] = 0.0;
+        flotte.altitudeCible[indice] = 10000.0;
         
+        pointDecollage = getPosition();
         setEtat(EtatAvion::ROULAGE_DECOLLAGE);
         enParking = false;
     }
 }
 
 void Avion::updateRoulageDecollage(double dt) {
-    vitesse = vitesse_roulage * 10.0;
-    cap = calculerCap(destination);
+    flotte.vitesse[indice] = vitesse_roulage * 10.0;
+    setCap(calculerCap(getDestination()));
 
-    double distance_parcourue = vitesse * dt;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
+    double distance_parcourue = flotte.vitesse[indice] * dt;
+    flotte.x[indice] += distance_parcourue * flotte.dirX[indice];
+    flotte.y[indice] += distance_parcourue * flotte.dirY[indice];
     
     tempsRoulageDebut += dt;  // Accumuler le temps
 
@@ -258,165 +273,81 @@ void Avion::updateRoulageDecollage(double dt) {
         tempsRoulageDebut = 0.0;  // Reset pour la prochaine fois
     }
 }
-void Avion::updateDecollage(double dt) {
-    
-    if (vitesse < vitesse_croisiere) {
-        vitesse += 50.0 * dt;  
-    }
-
-    position.altitude += vitesse_montee * 5.0 * dt;  
-
-    
-    double distance_parcourue = vitesse * dt * 10.0;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
 
-    if (position.altitude >= 200) {
-        setEtat(EtatAvion::MONTEE);
-        altitude_cible = 10000;
-    }
+void Avion::updateRoulageArrivee(double dt) {
+    setEtat(EtatAvion::PARKING);
+    flotte.vitesse[indice] = 0;
 }
 
-void Avion::updateMontee(double dt) {
-    
-    vitesse = vitesse_croisiere * 20.0;  
-
-    
-    position.altitude += vitesse_montee * 20.0 * dt;  
-
-    cap = calculerCap(destination);
-
-    double distance_parcourue = vitesse * dt;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
-
-    if (position.altitude >= altitude_cible) {
-        position.altitude = altitude_cible;
-        setEtat(EtatAvion::CROISIERE);
-    }
+double Avion::distanceVers(const Position& pos) const {
+    double dx = pos.x - flotte.x[indice];
+    double dy = pos.y - flotte.y[indice];
+    return sqrt(dx * dx + dy * dy);
 }
 
-void Avion::updateCroisiere(double dt) {
-    vitesse = vitesse_croisiere * 50.0;
-    cap = calculerCap(destination);
-
-    double distance_parcourue = vitesse * dt;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
-
-    double distance_restante = distanceVers(destination);
-
-    if (distance_restante < 5000.0) {  
-        vitesse = 0;
-        position = destination;
-        setEtat(EtatAvion::PARKING);
-        return;
-    }
-
-    
-    if (distance_restante < 150000.0) {  
-        setEtat(EtatAvion::DESCENTE);
-    }
+double Avion::calculerCap(const Position& cible) const {
+    double dx = cible.x - flotte.x[indice];
+    double dy = cible.y - flotte.y[indice];
+    double cap_rad = atan2(dy, dx);
+    return cap_rad * 180.0 / M_PI;
 }
-void Avion::updateDescente(double dt) {
-    position.altitude -= vitesse_descente * 10.0 * dt;
-    if (position.altitude < 0) position.altitude = 0;
-
-    if (vitesse > vitesse_croisiere * 0.7) {
-        vitesse -= 3.0 * dt;
-    }
-
-    cap = calculerCap(destination);
 
-    double distance_parcourue = vitesse * dt;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
-
-    double distance_dest = distanceVers(destination);
-
-    
-    if (distance_dest < 5000.0) {  
-        vitesse = 0;
-        position = destination;
-        position.altitude = 0;  
-        setEtat(EtatAvion::PARKING);
-        std::cout << "[" << nom << "]  Atterri et stationne\n";
+void Avion::direction(double& ux, double& uy) const {
+    // La flotte stocke le cap sous forme de vecteur unitaire
+    if (getEtat() == EtatAvion::CROISIERE) {
+        flotte.directionCroisiere(indice, ux, uy);
         return;
     }
-
-    if (position.altitude <= 1000) {
-        setEtat(EtatAvion::APPROCHE);
-    }
+    ux = flotte.dirX[indice];
+    uy = flotte.dirY[indice];
 }
 
-void Avion::updateApproche(double dt) {
-    position.altitude -= vitesse_descente * 5.0 * dt;
-    if (position.altitude < 0) position.altitude = 0;
-
-    if (vitesse > 80.0) {
-        vitesse -= 5.0 * dt;
-    }
-
-    cap = calculerCap(destination);
-
-    double distance_parcourue = vitesse * dt;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
-
-    double distance_dest = distanceVers(destination);
-
-    if (distance_dest < 5000.0) {
-        vitesse = 0;
-        position = destination;
-        position.altitude = 0;
-        setEtat(EtatAvion::PARKING);
-        std::cout << "[" << nom << "]  Atterri et stationne\n";
-        return;
-    }
-
-    
-    if (position.altitude <= 500) {
-        
-        setEtat(EtatAvion::ATTERRISSAGE);
-    }
+double Avion::getCap() const {
+    double ux, uy;
+    direction(ux, uy);
+    return atan2(uy, ux) * 180.0 / M_PI;
 }
 
-void Avion::updateAtterrissage(double dt) {
-    position.altitude -= vitesse_descente * 0.5 * dt;
-    if (position.altitude < 0) position.altitude = 0;
-
-    vitesse -= 15.0 * dt;
-    if (vitesse < 0) vitesse = 0;
+double Avion::getVitesseX() const {
+    double ux, uy;
+    direction(ux, uy);
+    return flotte.vitesse[indice] * ux;
+}
 
-    double distance_parcourue = vitesse * dt;
-    position.x += distance_parcourue * cos(cap * M_PI / 180.0);
-    position.y += distance_parcourue * sin(cap * M_PI / 180.0);
+double Avion::getVitesseY() const {
+    double ux, uy;
+    direction(ux, uy);
+    return flotte.vitesse[indice] * uy;
+}
 
-    double distance_destination = distanceVers(destination);
-    if (distance_destination < 5000.0) {
-        vitesse = 0;
-        position = destination;
-        setEtat(EtatAvion::PARKING);
-        std::cout << "[" << nom << "]  Atterri et stationne \n";
+double Avion::getVitesseVerticale() const {
+    // Mêmes taux que les noyaux de la flotte
+    switch (getEtat()) {
+    case EtatAvion::DECOLLAGE: return flotte.vitesseMontee[indice] * 5.0;
+    case EtatAvion::MONTEE: return flotte.vitesseMontee[indice] * 20.0;
+    case EtatAvion::DESCENTE: return -flotte.vitesseDescente[indice] * 10.0;
+    case EtatAvion::APPROCHE: return -flotte.vitesseDescente[indice] * 5.0;
+    case EtatAvion::ATTERRISSAGE: return -flotte.vitesseDescente[indice] * 0.5;
+    default: return 0.0;
     }
 }
 
-void Avion::updateRoulageArrivee(double dt) {
-    setEtat(EtatAvion::PARKING);
-    vitesse = 0;
+void Avion::setPosition(const Position& pos) {
+    flotte.x[indice] = pos.x;
+    flotte.y[indice] = pos.y;
+    flotte.altitude[indice] = pos.altitude;
 }
 
-double Avion::distanceVers(const Position& pos) const {
-    double dx = pos.x - position.x;
-    double dy = pos.y - position.y;
-    return sqrt(dx * dx + dy * dy);
+void Avion::setDestination(const Position& dest) {
+    flotte.destX[indice] = dest.x;
+    flotte.destY[indice] = dest.y;
+    flotte.destAltitude[indice] = dest.altitude;
+    flotte.aeroportDestination[indice] = AEROPORT_INCONNU;
 }
 
-double Avion::calculerCap(const Position& cible) const {
-    double dx = cible.x - position.x;
-    double dy = cible.y - position.y;
-    double cap_rad = atan2(dy, dx);
-    return cap_rad * 180.0 / M_PI;
+void Avion::setCap(double capDegres) {
+    flotte.dirX[indice] = cos(capDegres * M_PI / 180.0);
+    flotte.dirY[indice] = sin(capDegres * M_PI / 180.0);
 }
 
 void Avion::afficherEtat() const {
@@ -426,7 +357,7 @@ void Avion::afficherEtat() const {
 
 bool Avion::volTermine() const {
     
-    double distance = distanceVers(destination);
+    double distance = distanceVers(getDestination());
     return distance < 5000.0;
 }
 
@@ -443,16 +374,17 @@ void Avion::updateAttente(double dt) {
     }
 
     // Calculer la position sur le cercle
-    position.x = centre_attente.x + rayon_attente * cos(angle_attente);
-    position.y = centre_attente.y + rayon_attente * sin(angle_attente);
+    flotte.x[indice] = centre_attente.x + rayon_attente * cos(angle_attente);
+    flotte.y[indice] = centre_attente.y + rayon_attente * sin(angle_attente);
 
     // Maintenir l'altitude constante (2000m en attente)
-    position.altitude = 2000.0;
+    flotte.altitude[indice] = 2000.0;
 
     // Vitesse réduite en attente
-    vitesse = 80.0;
+    flotte.vitesse[indice] = 80.0;
 
     // Cap tangent au cercle (perpendiculaire au rayon)
-    cap = (angle_attente * 180.0 / M_PI) + 90.0;
+    double cap = (angle_attente * 180.0 / M_PI) + 90.0;
     if (cap > 360.0) cap -= 360.0;
+    setCap(cap);
 }
\ No newline at end of file
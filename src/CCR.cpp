@@ -4,8 +4,27 @@
 #include <cmath>
 #include <algorithm>
 
+namespace {
+
+    const double SEPARATION_MINIMALE = 5000.0;  // 5 km
+    const double SEPARATION_VERTICALE = 300.0;  // 300 m
+    const double DISTANCE_ALERTE = 10000.0;     // 10 km
+
+    bool perteSeparation(const Position& p1, const Position& p2) {
+        return p1.distanceTo(p2) < SEPARATION_MINIMALE &&
+            std::abs(p1.altitude - p2.altitude) < SEPARATION_VERTICALE;
+    }
+
+    bool risqueCollision(const Position& p1, const Position& p2) {
+        return p1.distance3DTo(p2) < DISTANCE_ALERTE;
+    }
+
+} // namespace
+
 CCR::CCR(const std::string& nom, double altitude)
-    : ControleurBase(nom), altitudeCroisiere(altitude) {
+    : ControleurBase(nom), altitudeCroisiere(altitude), compteurCycles(0),
+    grille(10000.0, 1000.0), sonde(1200.0, 5000.0, 300.0), compteurSonde(0),
+    poolDetection(nullptr) {
 }
 
 void CCR::ajouterAeroport(const std::string& nom, const Position& pos,
@@ -19,93 +38,147 @@ void CCR::ajouterAeroport(const std::string& nom, const Position& pos,
     aeroport.capaciteMax = capacite;
     aeroport.avionsEnApproche = 0;
 
-    aeroports[nom] = aeroport;
+    // Passations d'avions avec l'APP par canaux dédiés
+    if (app != nullptr) {
+        relier(*this, *app);
+    }
 
-    logAction("AJOUT_AEROPORT", "Aéroport " + nom + " ajouté au réseau");
+    auto it = indexAeroports.find(nom);
+    if (it != indexAeroports.end()) {
+        aeroports[it->second] = aeroport;
+    }
+    else {
+        indexAeroports[nom] = aeroports.size();
+        aeroports.push_back(aeroport);
+    }
+
+    EvenementTrace e(TypeEvenement::AJOUT_AEROPORT);
+    e.texte1 = &nom;
+    logEvenement(e);
 }
 
 void CCR::ajouterRoute(const std::string& depart, const std::string& arrivee) {
     std::lock_guard<std::mutex> lock(mtx);
 
-    auto itDepart = aeroports.find(depart);
-    auto itArrivee = aeroports.find(arrivee);
+    int iDepart = trouverAeroport(depart);
+    int iArrivee = trouverAeroport(arrivee);
 
-    if (itDepart == aeroports.end() || itArrivee == aeroports.end()) {
-        logAction("ERREUR_ROUTE", "Aéroport inexistant pour la route " +
-            depart + " -> " + arrivee);
+    if (iDepart < 0 || iArrivee < 0) {
+        EvenementTrace e(TypeEvenement::ERREUR_ROUTE);
+        e.texte1 = &depart;
+        e.texte2 = &arrivee;
+        logEvenement(e);
         return;
     }
 
     Route route;
     route.depart = depart;
     route.arrivee = arrivee;
-    route.distance = itDepart->second.position.distanceTo(itArrivee->second.position);
+    const Position& posDepart = aeroports[iDepart].position;
+    const Position& posArrivee = aeroports[iArrivee].position;
+    route.distance = posDepart.distanceTo(posArrivee);
 
     // Créer des waypoints simples (début, milieu, fin)
-    route.waypoints.push_back(itDepart->second.position);
+    route.waypoints.push_back(posDepart);
 
     Position milieu(
-        (itDepart->second.position.x + itArrivee->second.position.x) / 2.0,
-        (itDepart->second.position.y + itArrivee->second.position.y) / 2.0,
+        (posDepart.x + posArrivee.x) / 2.0,
+        (posDepart.y + posArrivee.y) / 2.0,
         altitudeCroisiere
     );
     route.waypoints.push_back(milieu);
-    route.waypoints.push_back(itArrivee->second.position);
+    route.waypoints.push_back(posArrivee);
+
+    // Les avions suivent les points de passage en croisière
+    ReseauRoutes::globale().ajouter(route.waypoints);
 
     routes.push_back(route);
 
-    logAction("AJOUT_ROUTE", "Route " + depart + " -> " + arrivee +
-        " ajoutée (" + std::to_string(static_cast<int>(route.distance / 1000)) + " km)");
+    EvenementTrace e(TypeEvenement::AJOUT_ROUTE);
+    e.texte1 = &depart;
+    e.texte2 = &arrivee;
+    e.valeur1 = route.distance / 1000;
+    logEvenement(e);
 }
 
 void CCR::creerVol(const std::string& nomAvion, const std::string& depart,
     const std::string& arrivee) {
     std::lock_guard<std::mutex> lock(mtx);
 
-    auto itDepart = aeroports.find(depart);
-    auto itArrivee = aeroports.find(arrivee);
+    int iDepart = trouverAeroport(depart);
+    int iArrivee = trouverAeroport(arrivee);
 
-    if (itDepart == aeroports.end() || itArrivee == aeroports.end()) {
-        logAction("ERREUR_VOL", "Impossible de créer le vol " + nomAvion +
-            " - aéroport inexistant");
+    if (iDepart < 0 || iArrivee < 0) {
+        EvenementTrace e(TypeEvenement::ERREUR_VOL);
+        e.texte1 = &nomAvion;
+        logEvenement(e);
         return;
     }
 
     // Vérifier la capacité de l'aéroport d'arrivée
-    if (!verifierCapaciteAeroport(arrivee)) {
-        logAction("VOL_RETARDE", "Vol " + nomAvion + " retardé - capacité " +
-            arrivee + " saturée");
+    if (!verifierCapaciteAeroport(iArrivee)) {
+        EvenementTrace e(TypeEvenement::VOL_RETARDE);
+        e.texte1 = &nomAvion;
+        e.texte2 = &arrivee;
+        logEvenement(e);
         return;
     }
 
-    // Créer l'avion
-    Position posDepart = itDepart->second.position;
-    posDepart.altitude = altitudeCroisiere;
-
-    Position posArrivee = itArrivee->second.position;
-    posArrivee.altitude = altitudeCroisiere;
+    // L'avion sera créé par l'ordonnanceur entre deux pas : ni le pool ni
+    // les colonnes de la flotte ne changent pendant les cycles
+    VolDemande vol;
+    vol.nomAvion = nomAvion;
+    vol.depart = depart;
+    vol.arrivee = arrivee;
+    vol.aeroportArrivee = iArrivee;
+    vol.positionDepart = aeroports[iDepart].position;
+    vol.positionDepart.altitude = altitudeCroisiere;
+    vol.positionArrivee = aeroports[iArrivee].position;
+    vol.positionArrivee.altitude = altitudeCroisiere;
+    volsDemandes.push_back(vol);
+
+    // Incrémenter le compteur de l'aéroport de destination dès la demande :
+    // les demandes suivantes en tiennent compte
+    aeroports[iArrivee].avionsEnApproche++;
+}
 
-    std::vector<Position> destinations = { posArrivee };  // Pour l'instant, une seule destination
-    Avion* avion = new Avion(nomAvion, posDepart, destinations);
+size_t CCR::creerAvionsDemandes() {
+    std::vector<VolDemande> demandes;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (volsDemandes.empty()) return 0;
+        demandes.swap(volsDemandes);
+    }
 
-    // Utiliser CROISIERE au lieu de EN_ROUTE qui n'existe pas dans l'enum
-    avion->setEtat(EtatAvion::CROISIERE);
+    PoolAvions& pool = PoolAvions::globale();
+    for (const auto& vol : demandes) {
+        std::vector<Position> destinations = { vol.positionArrivee };  // Pour l'instant, une seule destination
+        Avion* avion = pool.obtenir(pool.creer(vol.nomAvion, vol.positionDepart, destinations));
 
+        // Rendu au pool par l'ordonnanceur une fois stationné à l'arrivée
+        avion->setVolUnique(true);
 
-    ajouterAvion(avion);
+        // Utiliser CROISIERE au lieu de EN_ROUTE qui n'existe pas dans l'enum
+        avion->setEtat(EtatAvion::CROISIERE);
+        avion->setAeroportDestination(vol.aeroportArrivee);
 
-    // Incrémenter le compteur de l'aéroport de destination
-    aeroports[arrivee].avionsEnApproche++;
+        // ajouterAvion prend mtx
+        ajouterAvion(avion);
 
-    logAction("VOL_CREE", "Vol " + nomAvion + " créé: " + depart + " -> " + arrivee);
+        EvenementTrace e(TypeEvenement::VOL_CREE);
+        e.avion1 = avion->getId();
+        e.texte1 = &vol.depart;
+        e.texte2 = &vol.arrivee;
+        logEvenement(e);
+    }
+    return demandes.size();
 }
 
 void CCR::processLogic() {
-    static int compteur = 0;
-    if (compteur++ % 50 == 0) {
+    if (compteurCycles++ % 50 == 0) {
         std::cout << "[CCR] " << avionsSousControle.size() << " avions sous controle\n";
         for (auto* avion : avionsSousControle) {
-            Position pos = avion->getPosition();
+            Position pos = etatPublie(avion).getPosition();
             std::cout << "  - " << avion->getNom()
                 << " a (" << (int)(pos.x / 1000) << ", " << (int)(pos.y / 1000) << ") km"
                 << " | Etat: " << avion->getEtatString() << "\n";
@@ -113,106 +186,236 @@ void CCR::processLogic() {
     }
 
     gererSeparation();
+    gererConflitsPrevus();
     gererFlux();
     transfererVersAPP();
-    recupererAvionsEnCroisiere();  
 }
 
-void CCR::gererSeparation() {
-    
-
-    const double SEPARATION_MINIMALE = 5000.0; // 5 km
-    const double SEPARATION_VERTICALE = 300.0;  // 300 m
+void CCR::actualiserGrille() const {
+    // Une seule lecture de position par avion (toutes du même pas publié),
+    // puis déplacement dans la grille uniquement pour les avions qui ont
+    // changé de cellule
+    positionsControle.resize(avionsSousControle.size());
 
-    // Vérifier toutes les paires d'avions
+    grille.commencerMiseAJour();
     for (size_t i = 0; i < avionsSousControle.size(); i++) {
-        for (size_t j = i + 1; j < avionsSousControle.size(); j++) {
+        positionsControle[i] = etatPublie(avionsSousControle[i]).getPosition();
+        grille.mettreAJour(avionsSousControle[i], positionsControle[i], i);
+    }
+    grille.retirerAbsents();
+}
+
+template <typename Critere>
+std::vector<std::pair<size_t, size_t>> CCR::collecterPaires(double rayonH, double rayonV,
+    bool parallele, Critere critere) const {
+
+    // Vérifier uniquement les avions des cellules voisines ; chaque paire
+    // est examinée depuis l'avion de plus petit rang
+    auto parcourir = [&](size_t debut, size_t fin, std::vector<std::pair<size_t, size_t>>& paires) {
+        for (size_t i = debut; i < fin; i++) {
             Avion* a1 = avionsSousControle[i];
-            Avion* a2 = avionsSousControle[j];
+            const Position& pos1 = positionsControle[i];
 
-            Position pos1 = a1->getPosition();
-            Position pos2 = a2->getPosition();
+            grille.pourChaqueVoisin(pos1, rayonH, rayonV,
+                [&](const GrilleSpatiale::Entree& e) {
+                    if (e.rang <= i || e.avion == a1) return;
+                    if (critere(pos1, e.position)) {
+                        paires.push_back(std::make_pair(i, e.rang));
+                    }
+                });
+        }
+    };
+
+    std::vector<std::pair<size_t, size_t>> paires;
+
+    if (parallele && poolDetection) {
+        // Grille et positions en lecture seule : chaque thread remplit sa
+        // propre liste, fusionnée à la fin
+        std::vector<std::vector<std::pair<size_t, size_t>>> parThread(poolDetection->getNbThreads());
+        poolDetection->paralleliser(avionsSousControle.size(), TAILLE_LOT_DETECTION,
+            [&](size_t debut, size_t fin, size_t indiceThread) {
+                parcourir(debut, fin, parThread[indiceThread]);
+            });
+
+        size_t total = 0;
+        for (const auto& v : parThread) total += v.size();
+        paires.reserve(total);
+        for (const auto& v : parThread) {
+            paires.insert(paires.end(), v.begin(), v.end());
+        }
+    }
+    else {
+        parcourir(0, avionsSousControle.size(), paires);
+    }
+
+    // Même ordre que le parcours de toutes les paires (i, j), quel que soit le découpage
+    std::sort(paires.begin(), paires.end());
+    return paires;
+}
+
+void CCR::gererSeparation() {
+    std::lock_guard<std::mutex> lock(mtx);
+    actualiserGrille();
 
-            double distanceHorizontale = pos1.distanceTo(pos2);
-            double distanceVerticale = std::abs(pos1.altitude - pos2.altitude);
+    auto conflits = collecterPaires(SEPARATION_MINIMALE, SEPARATION_VERTICALE,
+        detectionParallele(), perteSeparation);
 
-            // Conflit détecté
-            if (distanceHorizontale < SEPARATION_MINIMALE &&
-                distanceVerticale < SEPARATION_VERTICALE) {
+    for (const auto& p : conflits) {
+        double distanceHorizontale = positionsControle[p.first].distanceTo(positionsControle[p.second]);
 
-                logAction("CONFLIT_DETECTE",
-                    "Conflit entre " + a1->getNom() + " et " + a2->getNom() +
-                    " - distance: " + std::to_string(static_cast<int>(distanceHorizontale)) + "m");
-            }
+        EvenementTrace e(TypeEvenement::CONFLIT_DETECTE);
+        e.avion1 = avionsSousControle[p.first]->getId();
+        e.avion2 = avionsSousControle[p.second]->getId();
+        e.valeur1 = distanceHorizontale;
+        logEvenement(e);
+    }
+}
+
+void CCR::activerDetectionParallele(PoolThreads* pool) {
+    std::lock_guard<std::mutex> lock(mtx);
+    poolDetection = pool;
+}
+
+bool CCR::detectionParallele() const {
+    return poolDetection && poolDetection->getNbThreads() > 1;
+}
+
+bool CCR::verifierDetectionParallele() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!poolDetection) return true;
+
+    actualiserGrille();
+
+    bool identiques =
+        collecterPaires(SEPARATION_MINIMALE, SEPARATION_VERTICALE, false, perteSeparation) ==
+        collecterPaires(SEPARATION_MINIMALE, SEPARATION_VERTICALE, true, perteSeparation) &&
+        collecterPaires(DISTANCE_ALERTE, DISTANCE_ALERTE, false, risqueCollision) ==
+        collecterPaires(DISTANCE_ALERTE, DISTANCE_ALERTE, true, risqueCollision);
+
+    if (!identiques) {
+        std::cerr << "[CCR] Detection parallele differente de la detection sequentielle\n";
+    }
+    return identiques;
+}
+
+std::vector<ConflitPrevu> CCR::sonderConflits() const {
+    std::vector<Trajectoire> trajectoires;
+    SondeConflits copieSonde;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        copieSonde = sonde;
+        trajectoires.reserve(avionsSousControle.size());
+        for (auto* avion : avionsSousControle) {
+            trajectoires.push_back(SondeConflits::extrapoler(avion));
         }
     }
+
+    return copieSonde.sonder(trajectoires);
+}
+
+void CCR::setHorizonSonde(double secondes) {
+    std::lock_guard<std::mutex> lock(mtx);
+    sonde.setHorizon(secondes);
+}
+
+void CCR::gererConflitsPrevus() {
+    if (compteurSonde++ % PERIODE_SONDE != 0) {
+        return;
+    }
+
+    for (const auto& conflit : sonderConflits()) {
+        EvenementTrace e(TypeEvenement::CONFLIT_PREVU);
+        e.avion1 = conflit.avion1->getId();
+        e.avion2 = conflit.avion2->getId();
+        e.valeur1 = conflit.tempsAvantConflit;
+        e.valeur2 = conflit.distanceMinimale;
+        logEvenement(e);
+    }
 }
 
 void CCR::gererFlux() {
 
     // Vérifier que les aéroports ne sont pas surchargés
-    for (auto& pair : aeroports) {
-        Aeroport& aeroport = pair.second;
-
+    for (auto& aeroport : aeroports) {
         if (aeroport.avionsEnApproche >= aeroport.capaciteMax) {
-            logAction("AEROPORT_SATURE",
-                "Aéroport " + aeroport.nom + " à capacité maximale (" +
-                std::to_string(aeroport.avionsEnApproche) + "/" +
-                std::to_string(aeroport.capaciteMax) + ")");
+            EvenementTrace e(TypeEvenement::AEROPORT_SATURE);
+            e.texte1 = &aeroport.nom;
+            e.valeur1 = aeroport.avionsEnApproche;
+            e.valeur2 = aeroport.capaciteMax;
+            logEvenement(e);
         }
     }
 }
 
 void CCR::transfererVersAPP() {
-    std::vector<Avion*> avionsARetirer;
+    std::vector<std::pair<Avion*, size_t>> aTransferer;
 
     for (auto* avion : avionsSousControle) {
-        Position pos = avion->getPosition();
-        Position dest = avion->getDestination();  // ← Récupérer la destination
+        // Aéroport de destination connu : un seul test de distance par avion
+        int iAeroport = resoudreAeroportDestination(avion);
+        if (iAeroport < 0) continue;
 
-        // Chercher l'aéroport de destination
-        for (auto& pair : aeroports) {
-            Aeroport& aeroport = pair.second;
+        Aeroport& aeroport = aeroports[iAeroport];
+        double distanceActuelle = etatPublie(avion).getPosition().distanceTo(aeroport.position);
 
-            // Vérifier si c'est bien la destination
-            double distanceDestVersAeroport = dest.distanceTo(aeroport.position);
-
-            // L'avion est proche de SON aéroport de destination
-            if (distanceDestVersAeroport < 10000.0) {  // Destination à moins de 10km de l'aéroport
-                double distanceActuelle = pos.distanceTo(aeroport.position);
-
-                // L'avion entre dans la zone d'approche (50 km)
-                if (distanceActuelle < 50000.0 && aeroport.controleurApproche != nullptr) {
-
-                    logAction("TRANSFERT_APP",
-                        "Avion " + avion->getNom() + " transféré à l'APP " + aeroport.nom);
+        // L'avion entre dans la zone d'approche (50 km)
+        if (distanceActuelle < 50000.0 && aeroport.controleurApproche != nullptr) {
+            aTransferer.push_back(std::make_pair(avion, static_cast<size_t>(iAeroport)));
+        }
+    }
 
-                    aeroport.controleurApproche->ajouterAvion(avion);
-                    avionsARetirer.push_back(avion);
+    // Offres à l'APP, acceptées à son cycle ; canal plein : l'avion reste
+    // au CCR et sera de nouveau offert au cycle suivant
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& t : aTransferer) {
+        Aeroport& aeroport = aeroports[t.second];
+        if (!offrirAvion(t.first, aeroport.controleurApproche)) continue;
 
-                    if (aeroport.avionsEnApproche > 0) {
-                        aeroport.avionsEnApproche--;
-                    }
+        EvenementTrace e(TypeEvenement::TRANSFERT_APP);
+        e.avion1 = t.first->getId();
+        e.texte1 = &aeroport.nom;
+        logEvenement(e);
 
-                    break;
-                }
-            }
+        if (aeroport.avionsEnApproche > 0) {
+            aeroport.avionsEnApproche--;
         }
     }
+}
 
-    // Retirer les avions transférés
-    for (auto* avion : avionsARetirer) {
-        retirerAvion(avion->getNom());
+bool CCR::verifierCapaciteAeroport(size_t aeroport) const {
+    if (aeroport >= aeroports.size()) {
+        return false;
     }
+
+    return aeroports[aeroport].avionsEnApproche < aeroports[aeroport].capaciteMax;
 }
 
-bool CCR::verifierCapaciteAeroport(const std::string& aeroportId) {
-    auto it = aeroports.find(aeroportId);
-    if (it == aeroports.end()) {
-        return false;
+int CCR::trouverAeroport(const std::string& nom) const {
+    auto it = indexAeroports.find(nom);
+    return it != indexAeroports.end() ? static_cast<int>(it->second) : -1;
+}
+
+int CCR::resoudreAeroportDestination(Avion* avion) const {
+    int iAeroport = avion->getAeroportDestination();
+    if (iAeroport != Avion::AEROPORT_INCONNU) {
+        return iAeroport;
+    }
+
+    // Première rencontre depuis le choix de la destination : aéroport le plus
+    // proche du point de destination, à moins de 10 km
+    Position dest = avion->getDestination();
+    double distanceMin = 10000.0;
+    iAeroport = Avion::AEROPORT_HORS_RESEAU;
+    for (size_t i = 0; i < aeroports.size(); i++) {
+        double d = dest.distanceTo(aeroports[i].position);
+        if (d < distanceMin) {
+            distanceMin = d;
+            iAeroport = static_cast<int>(i);
+        }
     }
 
-    return it->second.avionsEnApproche < it->second.capaciteMax;
+    avion->setAeroportDestination(iAeroport);
+    return iAeroport;
 }
 
 double CCR::calculerSeparationMinimale(const Avion* a1, const Avion* a2) const {
@@ -225,27 +428,25 @@ std::vector<std::pair<std::string, std::string>> CCR::detecterRisquesCollision()
     std::lock_guard<std::mutex> lock(mtx);
     std::vector<std::pair<std::string, std::string>> risques;
 
-    const double DISTANCE_ALERTE = 10000.0; // 10 km
+    actualiserGrille();
 
-    for (size_t i = 0; i < avionsSousControle.size(); i++) {
-        for (size_t j = i + 1; j < avionsSousControle.size(); j++) {
-            Position pos1 = avionsSousControle[i]->getPosition();
-            Position pos2 = avionsSousControle[j]->getPosition();
-            double distance = pos1.distance3DTo(pos2);
-
-            if (distance < DISTANCE_ALERTE) {
-                risques.push_back({
-                    avionsSousControle[i]->getNom(),
-                    avionsSousControle[j]->getNom()
-                    });
-            }
-        }
+    auto paires = collecterPaires(DISTANCE_ALERTE, DISTANCE_ALERTE,
+        detectionParallele(), risqueCollision);
+
+    for (const auto& p : paires) {
+        risques.push_back({
+            avionsSousControle[p.first]->getNom(),
+            avionsSousControle[p.second]->getNom()
+            });
     }
 
     return risques;
 }
 
 void CCR::afficherEspaceAerien() const {
+    // Détecter les risques avant de verrouiller : detecterRisquesCollision() prend mtx
+    auto risques = detecterRisquesCollision();
+
     std::lock_guard<std::mutex> lock(mtx);
 
     std::cout << "\n=== CCR - " << nom << " ===\n";
@@ -256,8 +457,7 @@ void CCR::afficherEspaceAerien() const {
         std::cout << "[" << avion->getNom() << "] -> " << avion->getEtatString() << "\n";
     }
 
-    // Détecter les risques de collision
-    auto risques = detecterRisquesCollision();
+    // Risques de collision
     if (!risques.empty()) {
         std::cout << "\nALERTES PROXIMITE:\n";
         for (const auto& paire : risques) {
@@ -267,72 +467,3 @@ void CCR::afficherEspaceAerien() const {
 
     std::cout << "===================\n";
 }
-void CCR::recupererAvionsEnCroisiere() {
-   
-
-    for (auto& pair : aeroports) {
-        Aeroport& aeroport = pair.second;
-
-        if (aeroport.controleurApproche == nullptr) continue;
-
-        std::vector<Avion*>& avionsAPP = aeroport.controleurApproche->getAvionsSousControle();
-
-        for (auto* avion : avionsAPP) {
-            if (avion == nullptr) continue;
-
-            EtatAvion etat = avion->getEtat();
-
-            // Si l'avion est en CROISIERE
-            if (etat == EtatAvion::CROISIERE) {
-                Position pos = avion->getPosition();
-                double distance = pos.distanceTo(aeroport.position);
-
-                // Si l'avion est loin de l'aéroport (> 60 km)
-                if (distance > 60000.0) {
-                    // Vérifier s'il n'est pas déjà dans le CCR
-                    bool dejaDansCCR = false;
-                    for (auto* a : avionsSousControle) {
-                        if (a->getNom() == avion->getNom()) {
-                            dejaDansCCR = true;
-                            break;
-                        }
-                    }
-
-                    if (!dejaDansCCR) {
-                        ajouterAvion(avion);
-                        logAction("RECUPERATION_AVION",
-                            "Avion " + avion->getNom() + " récupéré en croisière");
-                    }
-                }
-            }
-        }
-    }
-}
-
-void CCR::recevoirAvionDepuisAPP(Avion* avion, const std::string& aeroportDepart) {
-    if (avion == nullptr) {
-        return;
-    }
-
-    std::lock_guard<std::mutex> lock(mtx);
-
-    // Vérifier que l'avion n'est pas déjà sous notre contrôle
-    for (auto* a : avionsSousControle) {
-        if (a->getNom() == avion->getNom()) {
-            logAction("AVION_DEJA_PRESENT",
-                "Avion " + avion->getNom() + " déjà sous contrôle CCR");
-            return;
-        }
-    }
-
-    // Ajouter l'avion au CCR
-    ajouterAvion(avion);
-
-    // S'assurer qu'il est en croisière
-    if (avion->getEtat() != EtatAvion::CROISIERE) {
-        avion->setEtat(EtatAvion::CROISIERE);
-    }
-
-    logAction("AVION_RECU_APP",
-        "Avion " + avion->getNom() + " reçu depuis APP " + aeroportDepart);
-}
\ No newline at end of file
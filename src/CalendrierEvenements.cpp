@@ -0,0 +1,109 @@
+#include "../include/CalendrierEvenements.h"
+
+namespace {
+
+    inline unsigned premierBit(std::uint64_t mot) {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(mot));
+#else
+        unsigned n = 0;
+        while ((mot & 1u) == 0) {
+            mot >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+
+} // namespace
+
+CalendrierEvenements::CalendrierEvenements(size_t nbCases, std::uint64_t debut)
+    : courant(debut),
+    nombre(0) {
+    size_t n = 64;
+    while (n < nbCases) n <<= 1;
+
+    cases.resize(n);
+    occupees.assign(n / 64, 0);
+    masque = n - 1;
+}
+
+void CalendrierEvenements::placer(const ReveilPlanifie& r) {
+    size_t c = static_cast<size_t>(r.tick) & masque;
+    cases[c].push_back(r);
+    occupees[c / 64] |= std::uint64_t(1) << (c % 64);
+}
+
+void CalendrierEvenements::planifier(const ReveilPlanifie& r) {
+    ReveilPlanifie e = r;
+    if (e.tick < courant) e.tick = courant;
+
+    // Une case ne contient que des événements d'un seul tick de l'horizon
+    if (e.tick - courant < cases.size()) {
+        placer(e);
+    }
+    else {
+        lointains.push(e);
+    }
+    nombre++;
+}
+
+void CalendrierEvenements::verserLointains() {
+    while (!lointains.empty() && lointains.top().tick - courant < cases.size()) {
+        placer(lointains.top());
+        lointains.pop();
+    }
+}
+
+bool CalendrierEvenements::prochaineCaseOccupee(std::uint64_t& tick) const {
+    // Parcours du bitmap à partir de la case courante, une seule fois le tour
+    const size_t nbMots = occupees.size();
+    const size_t depart = static_cast<size_t>(courant) & masque;
+    size_t mot = depart / 64;
+    std::uint64_t bits = occupees[mot] & (~std::uint64_t(0) << (depart % 64));
+
+    for (size_t k = 0; k <= nbMots; k++) {
+        if (bits != 0) {
+            size_t c = mot * 64 + premierBit(bits);
+            size_t ecart = (c - depart) & masque;
+            tick = courant + ecart;
+            return true;
+        }
+        mot = (mot + 1) % nbMots;
+        bits = occupees[mot];
+        if (k + 1 == nbMots) {
+            // Retour au mot de départ : seuls les bits avant la case courante restent
+            bits &= ~(~std::uint64_t(0) << (depart % 64));
+        }
+    }
+    return false;
+}
+
+bool CalendrierEvenements::prochain(std::uint64_t& tick) const {
+    bool trouve = prochaineCaseOccupee(tick);
+
+    if (!lointains.empty() && (!trouve || lointains.top().tick < tick)) {
+        tick = lointains.top().tick;
+        trouve = true;
+    }
+    return trouve;
+}
+
+size_t CalendrierEvenements::extraire(std::uint64_t tick, std::vector<ReveilPlanifie>& sortie) {
+    if (tick < courant) return 0;
+
+    // Les cases sautées sont vides : aucun événement n'est antérieur à tick
+    courant = tick;
+    verserLointains();
+
+    size_t c = static_cast<size_t>(tick) & masque;
+    std::vector<ReveilPlanifie>& liste = cases[c];
+    size_t n = liste.size();
+    if (n == 0) return 0;
+
+    sortie.insert(sortie.end(), liste.begin(), liste.end());
+    liste.clear();
+    occupees[c / 64] &= ~(std::uint64_t(1) << (c % 64));
+    nombre -= n;
+    return n;
+}
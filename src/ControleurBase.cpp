@@ -2,141 +2,357 @@
 #include <chrono>
 #include <iostream>
 
-ControleurBase::ControleurBase(const std::string& _nom)
-    : nom(_nom), running(false) {
-    std::string logFileName = "log_" + nom + ".json";
-    logFile.open(logFileName, std::ios::app);
-    if (logFile.is_open()) {
-        logFile << "[\n";
-        logFile.flush();
-    }
+std::atomic<bool> ControleurBase::journalJSON(true);
+std::atomic<TraceBinaire*> ControleurBase::trace(nullptr);
+std::mutex ControleurBase::mtxConfigurationHistorique;
+ConfigurationHistorique ControleurBase::configurationHistorique;
+
+void ControleurBase::configurerJournaux(bool json, TraceBinaire* traceBinaire) {
+    journalJSON.store(json);
+    trace.store(traceBinaire);
+}
+
+void ControleurBase::configurerHistorique(const ConfigurationHistorique& configuration) {
+    std::lock_guard<std::mutex> lock(mtxConfigurationHistorique);
+    configurationHistorique = configuration;
+}
+
+ConfigurationHistorique ControleurBase::getConfigurationHistorique() {
+    std::lock_guard<std::mutex> lock(mtxConfigurationHistorique);
+    return configurationHistorique;
+}
+
+ControleurBase::ControleurBase(const std::string& _nom, size_t capaciteBoite)
+    : nom(_nom),
+    idControleur(RegistreAvions::globale().enregistrerControleur(this, _nom)),
+    historiqueMessages("historique_" + _nom, getConfigurationHistorique()),
+    boiteReception(capaciteBoite),
+    horloge(&Horloge::systeme()) {
+    fluxJournal = journalJSON.load() ? JournalAsynchrone::globale().ouvrir("log_" + nom + ".json") : -1;
 }
 
 ControleurBase::~ControleurBase() {
-    if (running.load()) {
-        arreter();
-    }
+    JournalAsynchrone::globale().fermer(fluxJournal);
 
-    if (logFile.is_open()) {
-        logFile << "]\n";
-        logFile.close();
-    }
+    RegistreAvions::globale().desenregistrerControleur(idControleur);
 }
 
 void ControleurBase::ajouterAvion(Avion* avion) {
     if (avion == nullptr) return;
 
     std::lock_guard<std::mutex> lock(mtx);
+
+    // Dj propritaire : l'avion est dj dans la liste
+    if (RegistreAvions::globale().attribuer(avion->getId(), idControleur) == idControleur) {
+        return;
+    }
     avionsSousControle.push_back(avion);
+
+    ReferenceAvion r;
+    r.poignee = avion->getPoignee();
+    r.id = avion->getId();
+    referencesSousControle.push_back(r);
 }
 
-void ControleurBase::retirerAvion(const std::string& avionId) {
-    std::lock_guard<std::mutex> lock(mtx);
+void ControleurBase::retirerAvion(Avion* avion) {
+    if (avion == nullptr) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        oublierAvion(avion);
+    }
+
+    // Sans effet si l'avion a dj t transfr  un autre contrleur
+    RegistreAvions::globale().liberer(avion->getId(), idControleur);
+}
+
+bool ControleurBase::oublierAvion(const Avion* avion) {
     for (size_t i = 0; i < avionsSousControle.size(); i++) {
-        if (avionsSousControle[i]->getNom() == avionId) {
+        if (avionsSousControle[i] == avion) {
+            decisions.erase(referencesSousControle[i].id);
             avionsSousControle.erase(avionsSousControle.begin() + i);
-            break;
+            referencesSousControle.erase(referencesSousControle.begin() + i);
+            return true;
         }
     }
+    return false;
 }
 
-std::vector<Avion*> ControleurBase::getAvions() const {
-    std::lock_guard<std::mutex> lock(mtx);
-    return avionsSousControle;
+void ControleurBase::appliquerEtat(Avion* avion, EtatAvion etat) {
+    const InstantaneFlotte* instantane = lectureCycle.getInstantane();
+    decisions[avion->getId()] = instantane != nullptr ? instantane->numero : 0;
+    avion->setEtat(etat);
 }
 
-void ControleurBase::envoyerMessage(const Message& msg) {
-    std::lock_guard<std::mutex> lock(mtx);
-    historiqueMessages.push_back(msg);
-    logMessage(msg);
-}
+bool ControleurBase::etatAJour(const Avion* avion) {
+    auto it = decisions.find(avion->getId());
+    if (it == decisions.end()) return true;
 
-std::vector<Message> ControleurBase::getMessagesRecus() const {
-    std::lock_guard<std::mutex> lock(mtx);
-    return historiqueMessages;
+    // Un avion absent de l'instantan est lu directement dans la flotte
+    const InstantaneFlotte* instantane = lectureCycle.getInstantane();
+    if (instantane != nullptr && instantane->numero <= it->second &&
+        instantane->trouver(avion->getId()) != nullptr) {
+        return false;
+    }
+    decisions.erase(it);
+    return true;
 }
 
+void ControleurBase::relier(ControleurBase& a, ControleurBase& b, size_t capacite) {
+    if (&a == &b || a.estRelie(b)) return;
 
-void ControleurBase::logMessage(const Message& msg) {
-    
-    if (logFile.is_open()) {
-        logFile << msg.toJSON() << ",\n";
-        logFile.flush();
-    }
+    std::shared_ptr<CanalTransfert> versB = std::make_shared<CanalTransfert>(capacite);
+    std::shared_ptr<CanalTransfert> versA = std::make_shared<CanalTransfert>(capacite);
+    a.canauxSortants[b.idControleur] = versB;
+    b.canauxEntrants.push_back(versB);
+    b.canauxSortants[a.idControleur] = versA;
+    a.canauxEntrants.push_back(versA);
 }
 
-void ControleurBase::logAction(const std::string& action, const std::string& details) {
-   
-    Message msg;
-    msg.expediteur = nom;
-    msg.destinataire = "LOG";
-    msg.type = action;
-    msg.contenu = details;
-    msg.avionId = "";
-    msg.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+bool ControleurBase::offrirAvion(Avion* avion, ControleurBase* destinataire) {
+    if (avion == nullptr || destinataire == nullptr) return false;
 
-    logMessage(msg);
-}
+    auto it = canauxSortants.find(destinataire->idControleur);
+    if (it == canauxSortants.end()) return false;
 
-void ControleurBase::demarrer() {
-    bool expected = false;
-    if (!running.compare_exchange_strong(expected, true)) {
-        std::cout << "[" << nom << "] Deja demarre\n";
-        return;
+    for (size_t i = 0; i < avionsSousControle.size(); i++) {
+        if (avionsSousControle[i] != avion) continue;
+
+        OffreTransfert offre;
+        offre.avion = avion;
+        offre.reference = referencesSousControle[i];
+        offre.expediteur = idControleur;
+        if (!it->second->deposer(offre)) return false;
+
+        decisions.erase(offre.reference.id);
+        avionsSousControle.erase(avionsSousControle.begin() + i);
+        referencesSousControle.erase(referencesSousControle.begin() + i);
+        return true;
     }
+    return false;
+}
 
-    try {
-        workerThread = std::thread([this]() {
-            std::cout << "[" << nom << "] Thread demarre\n";
+size_t ControleurBase::accepterTransferts() {
+    RegistreAvions& registre = RegistreAvions::globale();
+    const PoolAvions& pool = PoolAvions::globale();
+    size_t acceptes = 0;
 
-            while (running.load()) {
-                try {
-                    processLogic();
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
-                catch (const std::exception& e) {
-                    std::cerr << "[" << nom << "] Erreur dans processLogic: " << e.what() << "\n";
+    std::lock_guard<std::mutex> lock(mtx);
+    OffreTransfert offre;
+    for (auto& canal : canauxEntrants) {
+        while (canal->retirer(offre)) {
+            if (pool.estPerimee(offre.reference.poignee)) continue;
+
+            if (!registre.transferer(offre.reference.id, offre.expediteur, idControleur)) {
+                int proprietaire = registre.proprietaire(offre.reference.id);
+                if (proprietaire != idControleur) {
+                    // Repris par un autre contrleur : c'est  lui de le suivre
+                    if (proprietaire != RegistreAvions::AUCUN_CONTROLEUR) continue;
+
+                    // Libr entre-temps : l'avion n'est plus dans aucune
+                    // liste, il retourne  l'expditeur, qui le rclame au
+                    // registre  son prochain cycle. Sans canal retour (ou
+                    // canal plein), il reste libre dans le registre.
+                    auto retour = canauxSortants.find(offre.expediteur);
+                    if (retour != canauxSortants.end()) {
+                        offre.expediteur = RegistreAvions::AUCUN_CONTROLEUR;
+                        retour->second->deposer(offre);
+                    }
+                    continue;
                 }
-                catch (...) {
-                    std::cerr << "[" << nom << "] Erreur inconnue dans processLogic\n";
+
+                // Dj attribu  ce contrleur : ne pas l'ajouter deux fois
+                bool present = false;
+                for (const auto& r : referencesSousControle) {
+                    if (r.id == offre.reference.id) {
+                        present = true;
+                        break;
+                    }
                 }
+                if (present) continue;
             }
 
-            std::cout << "[" << nom << "] Thread arrete\n";
-            });
+            avionsSousControle.push_back(offre.avion);
+            referencesSousControle.push_back(offre.reference);
+            acceptes++;
+        }
+    }
+    return acceptes;
+}
+
+size_t ControleurBase::verifierPoignees() {
+    const PoolAvions& pool = PoolAvions::globale();
+    std::vector<std::pair<const Avion*, IdAvion>> disparus;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        // Compactage en place : l'ordre des avions restants est conserv
+        size_t j = 0;
+        for (size_t i = 0; i < avionsSousControle.size(); i++) {
+            if (pool.estPerimee(referencesSousControle[i].poignee)) {
+                disparus.push_back(std::make_pair(avionsSousControle[i], referencesSousControle[i].id));
+                decisions.erase(referencesSousControle[i].id);
+                continue;
+            }
+            avionsSousControle[j] = avionsSousControle[i];
+            referencesSousControle[j] = referencesSousControle[i];
+            j++;
+        }
+        avionsSousControle.resize(j);
+        referencesSousControle.resize(j);
     }
-    catch (const std::system_error& e) {
-        std::cerr << "[" << nom << "] ERREUR CRATION THREAD: " << e.what() << "\n";
-        running.store(false);
-        throw;
+
+    for (const auto& d : disparus) {
+        avionDisparu(d.first, d.second);
+
+        EvenementTrace e(TypeEvenement::POIGNEE_PERIMEE);
+        e.avion1 = d.second;
+        logEvenement(e);
     }
+    return disparus.size();
 }
 
-void ControleurBase::arreter() {
-    bool expected = true;
-    if (!running.compare_exchange_strong(expected, false)) {
-        return;
+void ControleurBase::retirerAvion(const std::string& avionId) {
+    IdAvion id = RegistreAvions::globale().trouver(avionId);
+    if (id == RegistreAvions::ID_INVALIDE) return;
+
+    {
+        // Par les rfrences : un avion dj rendu au pool n'est pas lu
+        std::lock_guard<std::mutex> lock(mtx);
+        for (size_t i = 0; i < referencesSousControle.size(); i++) {
+            if (referencesSousControle[i].id == id) {
+                decisions.erase(id);
+                avionsSousControle.erase(avionsSousControle.begin() + i);
+                referencesSousControle.erase(referencesSousControle.begin() + i);
+                break;
+            }
+        }
+    }
+    RegistreAvions::globale().liberer(id, idControleur);
+}
+
+std::vector<Avion*> ControleurBase::getAvions() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return avionsSousControle;
+}
+
+bool ControleurBase::aDuTravail() const {
+    if (boiteReception.taille() > 0) return true;
+    for (const auto& canal : canauxEntrants) {
+        if (!canal->estVide()) return true;
     }
 
-    if (workerThread.joinable()) {
-        try {
-            workerThread.join();
+    std::lock_guard<std::mutex> lock(mtx);
+    return !avionsSousControle.empty();
+}
+
+bool ControleurBase::envoyerMessage(const Message& msg) {
+    // Le texte libre doit survivre au cycle de l'expditeur : copi dans la case
+    return boiteReception.deposerAvec([&msg](MessageRecu& c) {
+        c.msg = msg;
+        if (msg.type == TypeEvenement::AUTRE) {
+            c.texte.assign(msg.charge.libre.texte, msg.charge.libre.longueur);
+            c.msg.charge.libre.texte = nullptr;
         }
-        catch (const std::system_error& e) {
-            std::cerr << "[" << nom << "] Erreur lors de l'arrt du thread: " << e.what() << "\n";
+    });
+}
+
+size_t ControleurBase::releverMessages() {
+    // Au plus une bote pleine par cycle : un flot continu d'envois ne bloque pas le cycle
+    tamponReleve.clear();
+    boiteReception.relever(boiteReception.getCapacite(), [this](MessageRecu& c) {
+        tamponReleve.push_back(c.msg);
+        if (c.msg.type == TypeEvenement::AUTRE) {
+            // La case est rendue aux expditeurs : le texte passe dans l'arne du cycle
+            tamponReleve.back().charge.libre.texte = arena.copier(c.texte.data(), c.texte.size());
         }
+    });
+
+    if (tamponReleve.empty()) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& msg : tamponReleve) {
+        logMessage(msg);
+        historiqueMessages.ajouter(msg);
+    }
+    return tamponReleve.size();
+}
+
+size_t ControleurBase::parcourirMessages(long debut, long fin, const HistoriqueMessages::Visiteur& f) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return historiqueMessages.parcourirIntervalle(debut, fin, f);
+}
+
+size_t ControleurBase::parcourirMessagesAvion(IdAvion avion, const HistoriqueMessages::Visiteur& f) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return historiqueMessages.parcourirAvion(avion, f);
+}
+
+size_t ControleurBase::parcourirMessagesRecents(size_t n, const HistoriqueMessages::Visiteur& f) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return historiqueMessages.parcourirRecents(n, f);
+}
+
+StatistiquesHistorique ControleurBase::getStatistiquesHistorique() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return historiqueMessages.getStatistiques();
+}
+
+
+void ControleurBase::logMessage(const Message& msg) {
+    
+    JournalAsynchrone::globale().ecrire(fluxJournal, msg);
+}
+
+void ControleurBase::logEvenement(const EvenementTrace& evenement) {
+    std::int64_t horodatage = static_cast<std::int64_t>(horloge->maintenant() * 1000.0);
+
+    TraceBinaire* t = trace.load(std::memory_order_acquire);
+    if (t != nullptr) {
+        t->ajouter(evenement, idControleur, nom, horodatage);
     }
+
+    if (fluxJournal < 0) return;
+
+    // Le contenu texte n'est reconstruit qu' l'criture du journal
+    TableTextes& textes = TableTextes::globale();
+    Message msg;
+    msg.expediteur = static_cast<std::int16_t>(idControleur);
+    msg.destinataire = Message::JOURNAL;
+    msg.type = evenement.type;
+    msg.charge.evenement.avion1 = evenement.avion1;
+    msg.charge.evenement.avion2 = evenement.avion2;
+    msg.charge.evenement.texte1 = evenement.texte1 ? textes.interner(*evenement.texte1) : TableTextes::AUCUN;
+    msg.charge.evenement.texte2 = evenement.texte2 ? textes.interner(*evenement.texte2) : TableTextes::AUCUN;
+    msg.charge.evenement.valeur1 = evenement.valeur1;
+    msg.charge.evenement.valeur2 = evenement.valeur2;
+    msg.timestamp = horodatage;
+
+    logMessage(msg);
 }
 
-std::string Message::toJSON() const {
-    return "{"
-        "\"expediteur\":\"" + expediteur + "\","
-        "\"destinataire\":\"" + destinataire + "\","
-        "\"type\":\"" + type + "\","
-        "\"avionId\":\"" + avionId + "\","
-        "\"contenu\":\"" + contenu + "\","
-        "\"timestamp\":" + std::to_string(timestamp) +
-        "}";
-}
\ No newline at end of file
+void ControleurBase::executerCycle() {
+    // Les textes libres du cycle prcdent ont t copis par leurs destinataires
+    arena.reinitialiser();
+
+    lectureCycle = Flotte::globale().lire();
+
+    try {
+        verifierPoignees();
+        accepterTransferts();
+        releverMessages();
+        processLogic();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[" << nom << "] Erreur dans processLogic: " << e.what() << "\n";
+    }
+    catch (...) {
+        std::cerr << "[" << nom << "] Erreur inconnue dans processLogic\n";
+    }
+
+    // Le tampon pingl redevient disponible pour le rdacteur
+    lectureCycle.liberer();
+}
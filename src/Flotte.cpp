@@ -0,0 +1,773 @@
+#include "../include/Flotte.h"
+#include "../include/Avion.h"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Les noyaux scalaires et AVX2 effectuent exactement les mêmes opérations
+// dans le même ordre (pas de FMA) : un avion obtient le même résultat, au bit
+// près, qu'il soit traité dans un registre vectoriel ou dans la boucle de fin.
+
+namespace {
+
+    const double DISTANCE_ARRIVEE = 5000.0;      // Arrivée à destination (5 km)
+    const double DISTANCE_DESCENTE = 150000.0;   // Début de descente (150 km)
+
+    inline std::uint8_t code(EtatAvion e) {
+        return static_cast<std::uint8_t>(e);
+    }
+
+    // Plan des avions qui ne sont jamais entrés en croisière
+    const std::shared_ptr<const PlanVol>& planVide() {
+        static const std::shared_ptr<const PlanVol> vide = std::make_shared<PlanVol>();
+        return vide;
+    }
+
+    // Vecteur unitaire vers la cible ; (1, 0) si l'avion est déjà dessus
+    inline void orienter(double px, double py, double cx, double cy,
+        double& ux, double& uy) {
+        double dx = cx - px;
+        double dy = cy - py;
+        double d = std::sqrt(dx * dx + dy * dy);
+        if (d > 0.0) {
+            ux = dx / d;
+            uy = dy / d;
+        }
+        else {
+            ux = 1.0;
+            uy = 0.0;
+        }
+    }
+
+    inline double distance(double px, double py, double cx, double cy) {
+        double dx = cx - px;
+        double dy = cy - py;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+#if defined(__AVX2__)
+    // Vrai si au moins un des 4 avions est dans l'état
+    inline bool contientEtat(const std::uint8_t* etats, std::uint8_t e) {
+        return etats[0] == e || etats[1] == e || etats[2] == e || etats[3] == e;
+    }
+
+    // Masque 64 bits par voie : avions dans l'état e
+    inline __m256d masqueEtat(const std::uint8_t* etats, std::uint8_t e) {
+        std::int32_t quatre;
+        std::memcpy(&quatre, etats, sizeof(quatre));
+        __m256i v = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(quatre));
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, _mm256_set1_epi64x(e)));
+    }
+
+    inline void orienter4(__m256d px, __m256d py, __m256d cx, __m256d cy,
+        __m256d& ux, __m256d& uy) {
+        __m256d dx = _mm256_sub_pd(cx, px);
+        __m256d dy = _mm256_sub_pd(cy, py);
+        __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        __m256d nonNul = _mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_GT_OQ);
+        ux = _mm256_blendv_pd(_mm256_set1_pd(1.0), _mm256_div_pd(dx, d), nonNul);
+        uy = _mm256_blendv_pd(_mm256_setzero_pd(), _mm256_div_pd(dy, d), nonNul);
+    }
+
+    inline __m256d distance4(__m256d px, __m256d py, __m256d cx, __m256d cy) {
+        __m256d dx = _mm256_sub_pd(cx, px);
+        __m256d dy = _mm256_sub_pd(cy, py);
+        return _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+    }
+
+    // a < 0 ? 0 : a (même sémantique que la version scalaire, y compris pour -0.0)
+    inline __m256d plancherZero(__m256d a) {
+        __m256d negatif = _mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_LT_OQ);
+        return _mm256_blendv_pd(a, _mm256_setzero_pd(), negatif);
+    }
+
+    // N'écrit que les voies actives du masque
+    inline void ecrire(double* p, __m256d ancien, __m256d nouveau, __m256d masque) {
+        _mm256_storeu_pd(p, _mm256_blendv_pd(ancien, nouveau, masque));
+    }
+
+    inline void ecrireTransitions(std::uint8_t* transitions, __m256d cond, EtatAvion suivant) {
+        int bits = _mm256_movemask_pd(cond);
+        for (int k = 0; k < 4; k++) {
+            if (bits & (1 << k)) {
+                transitions[k] = static_cast<std::uint8_t>(code(suivant) + 1);
+            }
+        }
+    }
+#endif
+
+    // FNV-1a 64 bits
+    template <typename T>
+    void melanger(std::uint64_t& h, const std::vector<T>& colonne) {
+        const unsigned char* octets = reinterpret_cast<const unsigned char*>(colonne.data());
+        for (size_t i = 0; i < colonne.size() * sizeof(T); i++) {
+            h ^= octets[i];
+            h *= 1099511628211ull;
+        }
+    }
+
+} // namespace
+
+Flotte::Flotte(size_t capacite) : tempsPublication(0.0) {
+    reserver(capacite);
+}
+
+Flotte& Flotte::globale() {
+    static Flotte instance;
+    return instance;
+}
+
+void Flotte::reserver(size_t capacite) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    x.reserve(capacite);
+    y.reserve(capacite);
+    altitude.reserve(capacite);
+    vitesse.reserve(capacite);
+    dirX.reserve(capacite);
+    dirY.reserve(capacite);
+    destX.reserve(capacite);
+    destY.reserve(capacite);
+    destAltitude.reserve(capacite);
+    altitudeCible.reserve(capacite);
+    vitesseCroisiere.reserve(capacite);
+    vitesseMontee.reserve(capacite);
+    vitesseDescente.reserve(capacite);
+    etat.reserve(capacite);
+    transition.reserve(capacite);
+    aeroportDestination.reserve(capacite);
+    plans.reserve(capacite);
+    debutCroisiere.reserve(capacite);
+    finCroisiere.reserve(capacite);
+    endormi.reserve(capacite);
+    generationReveil.reserve(capacite);
+    avions.reserve(capacite);
+}
+
+size_t Flotte::enregistrer(Avion* avion) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    x.push_back(0.0);
+    y.push_back(0.0);
+    altitude.push_back(0.0);
+    vitesse.push_back(0.0);
+    dirX.push_back(1.0);
+    dirY.push_back(0.0);
+    destX.push_back(0.0);
+    destY.push_back(0.0);
+    destAltitude.push_back(0.0);
+    altitudeCible.push_back(0.0);
+    vitesseCroisiere.push_back(0.0);
+    vitesseMontee.push_back(0.0);
+    vitesseDescente.push_back(0.0);
+    etat.push_back(code(EtatAvion::PARKING));
+    transition.push_back(0);
+    aeroportDestination.push_back(-1);
+    plans.push_back(planVide());
+    debutCroisiere.push_back(0.0);
+    finCroisiere.push_back(0.0);
+    endormi.push_back(0);
+    generationReveil.push_back(0);
+    avions.push_back(avion);
+
+    return avions.size() - 1;
+}
+
+std::uint64_t Flotte::empreinte() const {
+    // Croisières évaluées sur des copies : les colonnes ne sont pas touchées
+    std::vector<double> px(x), py(y), ux(dirX), uy(dirY);
+    const std::uint8_t e = code(EtatAvion::CROISIERE);
+    for (size_t i = 0; i < avions.size(); i++) {
+        if (etat[i] == e) plans[i]->evaluer(abscisseCroisiere(i, tempsPublication), px[i], py[i], ux[i], uy[i]);
+    }
+
+    std::uint64_t h = 14695981039346656037ull;
+    melanger(h, px);
+    melanger(h, py);
+    melanger(h, altitude);
+    melanger(h, vitesse);
+    melanger(h, ux);
+    melanger(h, uy);
+    melanger(h, destX);
+    melanger(h, destY);
+    melanger(h, destAltitude);
+    melanger(h, etat);
+    return h;
+}
+
+void Flotte::publier(double temps) {
+    InstantaneFlotte* instantane = publication.preparer();
+    if (instantane == nullptr) return;
+
+    tempsPublication = temps;
+    const size_t n = avions.size();
+    instantane->temps = temps;
+    instantane->avions.resize(n);
+    instantane->croisieres.resize(n);
+
+    // Croisière : seuls le plan et l'instant d'entrée sont publiés, la
+    // position est évaluée par le lecteur (InstantaneFlotte::evaluer)
+    const std::uint8_t croisiere = code(EtatAvion::CROISIERE);
+    IdAvion idMax = 0;
+    for (size_t i = 0; i < n; i++) {
+        CroisierePubliee& c = instantane->croisieres[i];
+        if (etat[i] == croisiere) {
+            // Le tampon garde le plan d'une publication à l'autre : pas de
+            // compteur de références touché tant que le plan ne change pas
+            if (c.plan != plans[i]) c.plan = plans[i];
+            c.debut = debutCroisiere[i];
+            c.vitesseCroisiere = vitesseCroisiere[i];
+        }
+        else if (c.plan) {
+            c.plan.reset();
+        }
+
+        EtatPublie& e = instantane->avions[i];
+        e.id = avions[i]->getId();
+        e.etat = etat[i];
+        e.x = x[i];
+        e.y = y[i];
+        e.altitude = altitude[i];
+        e.vitesse = vitesse[i];
+        e.dirX = dirX[i];
+        e.dirY = dirY[i];
+        if (e.id + 1 > idMax) idMax = e.id + 1;
+    }
+
+    // Les entrées périmées sont écartées par trouver() (contrôle de l'id) ;
+    // les identifiants recyclés par le registre bornent la table
+    if (instantane->indiceParId.size() < idMax) {
+        instantane->indiceParId.resize(idMax, 0xFFFFFFFFu);
+    }
+    for (size_t i = 0; i < n; i++) {
+        instantane->indiceParId[instantane->avions[i].id] = static_cast<std::uint32_t>(i);
+    }
+
+    publication.publier(instantane);
+}
+
+void Flotte::retirer(size_t indice) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (indice >= avions.size()) return;
+
+    // Le dernier avion prend la place libérée pour garder les colonnes denses
+    size_t dernier = avions.size() - 1;
+    if (indice != dernier) {
+        x[indice] = x[dernier];
+        y[indice] = y[dernier];
+        altitude[indice] = altitude[dernier];
+        vitesse[indice] = vitesse[dernier];
+        dirX[indice] = dirX[dernier];
+        dirY[indice] = dirY[dernier];
+        destX[indice] = destX[dernier];
+        destY[indice] = destY[dernier];
+        destAltitude[indice] = destAltitude[dernier];
+        altitudeCible[indice] = altitudeCible[dernier];
+        vitesseCroisiere[indice] = vitesseCroisiere[dernier];
+        vitesseMontee[indice] = vitesseMontee[dernier];
+        vitesseDescente[indice] = vitesseDescente[dernier];
+        etat[indice] = etat[dernier];
+        transition[indice] = transition[dernier];
+        aeroportDestination[indice] = aeroportDestination[dernier];
+        plans[indice] = std::move(plans[dernier]);
+        debutCroisiere[indice] = debutCroisiere[dernier];
+        finCroisiere[indice] = finCroisiere[dernier];
+        // Son réveil planifié vise l'ancien indice : l'avion est réintégré
+        // pas à pas
+        endormi[indice] = 0;
+        generationReveil[indice] = generationReveil[dernier] + 1;
+        avions[indice] = avions[dernier];
+        avions[indice]->indice = indice;
+    }
+
+    x.pop_back();
+    y.pop_back();
+    altitude.pop_back();
+    vitesse.pop_back();
+    dirX.pop_back();
+    dirY.pop_back();
+    destX.pop_back();
+    destY.pop_back();
+    destAltitude.pop_back();
+    altitudeCible.pop_back();
+    vitesseCroisiere.pop_back();
+    vitesseMontee.pop_back();
+    vitesseDescente.pop_back();
+    etat.pop_back();
+    transition.pop_back();
+    aeroportDestination.pop_back();
+    plans.pop_back();
+    debutCroisiere.pop_back();
+    finCroisiere.pop_back();
+    endormi.pop_back();
+    generationReveil.pop_back();
+    avions.pop_back();
+}
+
+void Flotte::demarrerCroisiere(size_t i, std::shared_ptr<const PlanVol> plan, double temps) {
+    plans[i] = std::move(plan);
+    debutCroisiere[i] = temps;
+    vitesse[i] = vitesseCroisiere[i] * 50.0;
+
+    // Même seuil de descente que le vol pas à pas
+    double libre = plans[i]->getLongueur() - DISTANCE_DESCENTE;
+    if (libre < 0.0) libre = 0.0;
+    finCroisiere[i] = vitesse[i] > 0.0 ? temps + libre / vitesse[i] : temps;
+
+    evaluerCroisiere(i, temps);
+}
+
+double Flotte::abscisse(const PlanVol& plan, double debut, double vitesseCroisiere, double temps) {
+    double s = (temps - debut) * vitesseCroisiere * 50.0;
+    if (s < 0.0) s = 0.0;
+    if (s > plan.getLongueur()) s = plan.getLongueur();
+    return s;
+}
+
+double Flotte::abscisseCroisiere(size_t i, double temps) const {
+    return abscisse(*plans[i], debutCroisiere[i], vitesseCroisiere[i], temps);
+}
+
+Position Flotte::positionCroisiere(size_t i, double temps) const {
+    double px = x[i], py = y[i], ux, uy;
+    plans[i]->evaluer(abscisseCroisiere(i, temps), px, py, ux, uy);
+    return Position(px, py, altitude[i]);
+}
+
+void Flotte::directionCroisiere(size_t i, double& ux, double& uy) const {
+    double px, py;
+    ux = dirX[i];
+    uy = dirY[i];
+    plans[i]->evaluer(abscisseCroisiere(i, tempsPublication), px, py, ux, uy);
+}
+
+void Flotte::evaluerCroisiere(size_t i, double temps) {
+    plans[i]->evaluer(abscisseCroisiere(i, temps), x[i], y[i], dirX[i], dirY[i]);
+}
+
+std::uint32_t Flotte::endormir(size_t i) {
+    endormi[i] = 1;
+    return ++generationReveil[i];
+}
+
+void Flotte::reveiller(size_t i, double temps) {
+    if (!endormi[i]) return;
+
+    if (etat[i] == code(EtatAvion::CROISIERE)) {
+        evaluerCroisiere(i, temps);
+    }
+    endormi[i] = 0;
+    generationReveil[i]++;
+}
+
+bool Flotte::noyauxSIMD() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool Flotte::estCinematique(EtatAvion e) {
+    switch (e) {
+    case EtatAvion::DECOLLAGE:
+    case EtatAvion::MONTEE:
+    case EtatAvion::CROISIERE:
+    case EtatAvion::DESCENTE:
+    case EtatAvion::APPROCHE:
+    case EtatAvion::ATTERRISSAGE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void Flotte::avancer(EtatAvion e, size_t debut, size_t fin, double dt, double temps) {
+    switch (e) {
+    case EtatAvion::DECOLLAGE: noyauDecollage(debut, fin, dt); break;
+    case EtatAvion::MONTEE: noyauMontee(debut, fin, dt); break;
+    case EtatAvion::CROISIERE: noyauCroisiere(debut, fin, temps); break;
+    case EtatAvion::DESCENTE: noyauDescente(debut, fin, dt); break;
+    case EtatAvion::APPROCHE: noyauApproche(debut, fin, dt); break;
+    case EtatAvion::ATTERRISSAGE: noyauAtterrissage(debut, fin, dt); break;
+    default: break;
+    }
+}
+
+void Flotte::avancerCinematique(size_t debut, size_t fin, double dt, double temps) {
+    noyauDecollage(debut, fin, dt);
+    noyauMontee(debut, fin, dt);
+    noyauCroisiere(debut, fin, temps);
+    noyauDescente(debut, fin, dt);
+    noyauApproche(debut, fin, dt);
+    noyauAtterrissage(debut, fin, dt);
+}
+
+void Flotte::noyauDecollage(size_t debut, size_t fin, double dt) {
+    const std::uint8_t e = code(EtatAvion::DECOLLAGE);
+    size_t i = debut;
+
+#if defined(__AVX2__)
+    const __m256d vdt = _mm256_set1_pd(dt);
+    for (; i + 4 <= fin; i += 4) {
+        if (!contientEtat(&etat[i], e)) continue;
+        __m256d m = masqueEtat(&etat[i], e);
+
+        __m256d v0 = _mm256_loadu_pd(&vitesse[i]);
+        __m256d vc = _mm256_loadu_pd(&vitesseCroisiere[i]);
+        __m256d accelere = _mm256_cmp_pd(v0, vc, _CMP_LT_OQ);
+        __m256d v = _mm256_blendv_pd(v0,
+            _mm256_add_pd(v0, _mm256_mul_pd(_mm256_set1_pd(50.0), vdt)), accelere);
+
+        __m256d alt0 = _mm256_loadu_pd(&altitude[i]);
+        __m256d vm = _mm256_loadu_pd(&vitesseMontee[i]);
+        __m256d alt = _mm256_add_pd(alt0, _mm256_mul_pd(_mm256_mul_pd(vm, _mm256_set1_pd(5.0)), vdt));
+
+        __m256d pas = _mm256_mul_pd(_mm256_mul_pd(v, vdt), _mm256_set1_pd(10.0));
+        __m256d x0 = _mm256_loadu_pd(&x[i]);
+        __m256d y0 = _mm256_loadu_pd(&y[i]);
+        __m256d px = _mm256_add_pd(x0, _mm256_mul_pd(pas, _mm256_loadu_pd(&dirX[i])));
+        __m256d py = _mm256_add_pd(y0, _mm256_mul_pd(pas, _mm256_loadu_pd(&dirY[i])));
+
+        __m256d fin4 = _mm256_and_pd(m, _mm256_cmp_pd(alt, _mm256_set1_pd(200.0), _CMP_GE_OQ));
+        ecrire(&altitudeCible[i], _mm256_loadu_pd(&altitudeCible[i]), _mm256_set1_pd(10000.0), fin4);
+
+        ecrire(&vitesse[i], v0, v, m);
+        ecrire(&altitude[i], alt0, alt, m);
+        ecrire(&x[i], x0, px, m);
+        ecrire(&y[i], y0, py, m);
+        ecrireTransitions(&transition[i], fin4, EtatAvion::MONTEE);
+    }
+#endif
+
+    for (; i < fin; i++) {
+        if (etat[i] != e) continue;
+
+        if (vitesse[i] < vitesseCroisiere[i]) {
+            vitesse[i] = vitesse[i] + 50.0 * dt;
+        }
+        altitude[i] = altitude[i] + vitesseMontee[i] * 5.0 * dt;
+
+        double pas = vitesse[i] * dt * 10.0;
+        x[i] = x[i] + pas * dirX[i];
+        y[i] = y[i] + pas * dirY[i];
+
+        if (altitude[i] >= 200.0) {
+            altitudeCible[i] = 10000.0;
+            transition[i] = code(EtatAvion::MONTEE) + 1;
+        }
+    }
+}
+
+void Flotte::noyauMontee(size_t debut, size_t fin, double dt) {
+    const std::uint8_t e = code(EtatAvion::MONTEE);
+    size_t i = debut;
+
+#if defined(__AVX2__)
+    const __m256d vdt = _mm256_set1_pd(dt);
+    for (; i + 4 <= fin; i += 4) {
+        if (!contientEtat(&etat[i], e)) continue;
+        __m256d m = masqueEtat(&etat[i], e);
+
+        __m256d v = _mm256_mul_pd(_mm256_loadu_pd(&vitesseCroisiere[i]), _mm256_set1_pd(20.0));
+        __m256d alt0 = _mm256_loadu_pd(&altitude[i]);
+        __m256d vm = _mm256_loadu_pd(&vitesseMontee[i]);
+        __m256d alt = _mm256_add_pd(alt0, _mm256_mul_pd(_mm256_mul_pd(vm, _mm256_set1_pd(20.0)), vdt));
+
+        __m256d x0 = _mm256_loadu_pd(&x[i]);
+        __m256d y0 = _mm256_loadu_pd(&y[i]);
+        __m256d ux, uy;
+        orienter4(x0, y0, _mm256_loadu_pd(&destX[i]), _mm256_loadu_pd(&destY[i]), ux, uy);
+
+        __m256d pas = _mm256_mul_pd(v, vdt);
+        __m256d px = _mm256_add_pd(x0, _mm256_mul_pd(pas, ux));
+        __m256d py = _mm256_add_pd(y0, _mm256_mul_pd(pas, uy));
+
+        __m256d cible = _mm256_loadu_pd(&altitudeCible[i]);
+        __m256d atteinte = _mm256_cmp_pd(alt, cible, _CMP_GE_OQ);
+        alt = _mm256_blendv_pd(alt, cible, atteinte);
+
+        ecrire(&vitesse[i], _mm256_loadu_pd(&vitesse[i]), v, m);
+        ecrire(&altitude[i], alt0, alt, m);
+        ecrire(&dirX[i], _mm256_loadu_pd(&dirX[i]), ux, m);
+        ecrire(&dirY[i], _mm256_loadu_pd(&dirY[i]), uy, m);
+        ecrire(&x[i], x0, px, m);
+        ecrire(&y[i], y0, py, m);
+        ecrireTransitions(&transition[i], _mm256_and_pd(m, atteinte), EtatAvion::CROISIERE);
+    }
+#endif
+
+    for (; i < fin; i++) {
+        if (etat[i] != e) continue;
+
+        vitesse[i] = vitesseCroisiere[i] * 20.0;
+        altitude[i] = altitude[i] + vitesseMontee[i] * 20.0 * dt;
+
+        orienter(x[i], y[i], destX[i], destY[i], dirX[i], dirY[i]);
+
+        double pas = vitesse[i] * dt;
+        x[i] = x[i] + pas * dirX[i];
+        y[i] = y[i] + pas * dirY[i];
+
+        if (altitude[i] >= altitudeCible[i]) {
+            altitude[i] = altitudeCible[i];
+            transition[i] = code(EtatAvion::CROISIERE) + 1;
+        }
+    }
+}
+
+void Flotte::noyauCroisiere(size_t debut, size_t fin, double temps) {
+    // Position en forme close (evaluerCroisiere) : le pas se réduit à
+    // comparer le temps à la fin de croisière prévue
+    const std::uint8_t e = code(EtatAvion::CROISIERE);
+
+    for (size_t i = debut; i < fin; i++) {
+        if (etat[i] != e || temps < finCroisiere[i]) continue;
+
+        evaluerCroisiere(i, temps);
+        double reste = plans[i]->getLongueur() - abscisseCroisiere(i, temps);
+
+        if (reste < DISTANCE_ARRIVEE) {
+            vitesse[i] = 0.0;
+            x[i] = destX[i];
+            y[i] = destY[i];
+            altitude[i] = destAltitude[i];
+            transition[i] = code(EtatAvion::PARKING) + 1;
+        }
+        else {
+            transition[i] = code(EtatAvion::DESCENTE) + 1;
+        }
+    }
+}
+
+void Flotte::noyauDescente(size_t debut, size_t fin, double dt) {
+    const std::uint8_t e = code(EtatAvion::DESCENTE);
+    size_t i = debut;
+
+#if defined(__AVX2__)
+    const __m256d vdt = _mm256_set1_pd(dt);
+    for (; i + 4 <= fin; i += 4) {
+        if (!contientEtat(&etat[i], e)) continue;
+        __m256d m = masqueEtat(&etat[i], e);
+
+        __m256d alt0 = _mm256_loadu_pd(&altitude[i]);
+        __m256d vd = _mm256_loadu_pd(&vitesseDescente[i]);
+        __m256d alt = plancherZero(_mm256_sub_pd(alt0, _mm256_mul_pd(_mm256_mul_pd(vd, _mm256_set1_pd(10.0)), vdt)));
+
+        __m256d v0 = _mm256_loadu_pd(&vitesse[i]);
+        __m256d seuil = _mm256_mul_pd(_mm256_loadu_pd(&vitesseCroisiere[i]), _mm256_set1_pd(0.7));
+        __m256d ralentit = _mm256_cmp_pd(v0, seuil, _CMP_GT_OQ);
+        __m256d v = _mm256_blendv_pd(v0, _mm256_sub_pd(v0, _mm256_mul_pd(_mm256_set1_pd(3.0), vdt)), ralentit);
+
+        __m256d x0 = _mm256_loadu_pd(&x[i]);
+        __m256d y0 = _mm256_loadu_pd(&y[i]);
+        __m256d cx = _mm256_loadu_pd(&destX[i]);
+        __m256d cy = _mm256_loadu_pd(&destY[i]);
+        __m256d ux, uy;
+        orienter4(x0, y0, cx, cy, ux, uy);
+
+        __m256d pas = _mm256_mul_pd(v, vdt);
+        __m256d px = _mm256_add_pd(x0, _mm256_mul_pd(pas, ux));
+        __m256d py = _mm256_add_pd(y0, _mm256_mul_pd(pas, uy));
+
+        __m256d reste = distance4(px, py, cx, cy);
+        __m256d arrive = _mm256_and_pd(m, _mm256_cmp_pd(reste, _mm256_set1_pd(DISTANCE_ARRIVEE), _CMP_LT_OQ));
+        __m256d approche = _mm256_andnot_pd(arrive,
+            _mm256_and_pd(m, _mm256_cmp_pd(alt, _mm256_set1_pd(1000.0), _CMP_LE_OQ)));
+
+        v = _mm256_blendv_pd(v, _mm256_setzero_pd(), arrive);
+        px = _mm256_blendv_pd(px, cx, arrive);
+        py = _mm256_blendv_pd(py, cy, arrive);
+        alt = _mm256_blendv_pd(alt, _mm256_setzero_pd(), arrive);
+
+        ecrire(&vitesse[i], v0, v, m);
+        ecrire(&altitude[i], alt0, alt, m);
+        ecrire(&dirX[i], _mm256_loadu_pd(&dirX[i]), ux, m);
+        ecrire(&dirY[i], _mm256_loadu_pd(&dirY[i]), uy, m);
+        ecrire(&x[i], x0, px, m);
+        ecrire(&y[i], y0, py, m);
+        ecrireTransitions(&transition[i], arrive, EtatAvion::PARKING);
+        ecrireTransitions(&transition[i], approche, EtatAvion::APPROCHE);
+    }
+#endif
+
+    for (; i < fin; i++) {
+        if (etat[i] != e) continue;
+
+        altitude[i] = altitude[i] - vitesseDescente[i] * 10.0 * dt;
+        if (altitude[i] < 0) altitude[i] = 0;
+
+        if (vitesse[i] > vitesseCroisiere[i] * 0.7) {
+            vitesse[i] = vitesse[i] - 3.0 * dt;
+        }
+
+        orienter(x[i], y[i], destX[i], destY[i], dirX[i], dirY[i]);
+
+        double pas = vitesse[i] * dt;
+        x[i] = x[i] + pas * dirX[i];
+        y[i] = y[i] + pas * dirY[i];
+
+        double reste = distance(x[i], y[i], destX[i], destY[i]);
+
+        if (reste < DISTANCE_ARRIVEE) {
+            vitesse[i] = 0.0;
+            x[i] = destX[i];
+            y[i] = destY[i];
+            altitude[i] = 0.0;
+            transition[i] = code(EtatAvion::PARKING) + 1;
+        }
+        else if (altitude[i] <= 1000.0) {
+            transition[i] = code(EtatAvion::APPROCHE) + 1;
+        }
+    }
+}
+
+void Flotte::noyauApproche(size_t debut, size_t fin, double dt) {
+    const std::uint8_t e = code(EtatAvion::APPROCHE);
+    size_t i = debut;
+
+#if defined(__AVX2__)
+    const __m256d vdt = _mm256_set1_pd(dt);
+    for (; i + 4 <= fin; i += 4) {
+        if (!contientEtat(&etat[i], e)) continue;
+        __m256d m = masqueEtat(&etat[i], e);
+
+        __m256d alt0 = _mm256_loadu_pd(&altitude[i]);
+        __m256d vd = _mm256_loadu_pd(&vitesseDescente[i]);
+        __m256d alt = plancherZero(_mm256_sub_pd(alt0, _mm256_mul_pd(_mm256_mul_pd(vd, _mm256_set1_pd(5.0)), vdt)));
+
+        __m256d v0 = _mm256_loadu_pd(&vitesse[i]);
+        __m256d ralentit = _mm256_cmp_pd(v0, _mm256_set1_pd(80.0), _CMP_GT_OQ);
+        __m256d v = _mm256_blendv_pd(v0, _mm256_sub_pd(v0, _mm256_mul_pd(_mm256_set1_pd(5.0), vdt)), ralentit);
+
+        __m256d x0 = _mm256_loadu_pd(&x[i]);
+        __m256d y0 = _mm256_loadu_pd(&y[i]);
+        __m256d cx = _mm256_loadu_pd(&destX[i]);
+        __m256d cy = _mm256_loadu_pd(&destY[i]);
+        __m256d ux, uy;
+        orienter4(x0, y0, cx, cy, ux, uy);
+
+        __m256d pas = _mm256_mul_pd(v, vdt);
+        __m256d px = _mm256_add_pd(x0, _mm256_mul_pd(pas, ux));
+        __m256d py = _mm256_add_pd(y0, _mm256_mul_pd(pas, uy));
+
+        __m256d reste = distance4(px, py, cx, cy);
+        __m256d arrive = _mm256_and_pd(m, _mm256_cmp_pd(reste, _mm256_set1_pd(DISTANCE_ARRIVEE), _CMP_LT_OQ));
+        __m256d atterrit = _mm256_andnot_pd(arrive,
+            _mm256_and_pd(m, _mm256_cmp_pd(alt, _mm256_set1_pd(500.0), _CMP_LE_OQ)));
+
+        v = _mm256_blendv_pd(v, _mm256_setzero_pd(), arrive);
+        px = _mm256_blendv_pd(px, cx, arrive);
+        py = _mm256_blendv_pd(py, cy, arrive);
+        alt = _mm256_blendv_pd(alt, _mm256_setzero_pd(), arrive);
+
+        ecrire(&vitesse[i], v0, v, m);
+        ecrire(&altitude[i], alt0, alt, m);
+        ecrire(&dirX[i], _mm256_loadu_pd(&dirX[i]), ux, m);
+        ecrire(&dirY[i], _mm256_loadu_pd(&dirY[i]), uy, m);
+        ecrire(&x[i], x0, px, m);
+        ecrire(&y[i], y0, py, m);
+        ecrireTransitions(&transition[i], arrive, EtatAvion::PARKING);
+        ecrireTransitions(&transition[i], atterrit, EtatAvion::ATTERRISSAGE);
+    }
+#endif
+
+    for (; i < fin; i++) {
+        if (etat[i] != e) continue;
+
+        altitude[i] = altitude[i] - vitesseDescente[i] * 5.0 * dt;
+        if (altitude[i] < 0) altitude[i] = 0;
+
+        if (vitesse[i] > 80.0) {
+            vitesse[i] = vitesse[i] - 5.0 * dt;
+        }
+
+        orienter(x[i], y[i], destX[i], destY[i], dirX[i], dirY[i]);
+
+        double pas = vitesse[i] * dt;
+        x[i] = x[i] + pas * dirX[i];
+        y[i] = y[i] + pas * dirY[i];
+
+        double reste = distance(x[i], y[i], destX[i], destY[i]);
+
+        if (reste < DISTANCE_ARRIVEE) {
+            vitesse[i] = 0.0;
+            x[i] = destX[i];
+            y[i] = destY[i];
+            altitude[i] = 0.0;
+            transition[i] = code(EtatAvion::PARKING) + 1;
+        }
+        else if (altitude[i] <= 500.0) {
+            transition[i] = code(EtatAvion::ATTERRISSAGE) + 1;
+        }
+    }
+}
+
+void Flotte::noyauAtterrissage(size_t debut, size_t fin, double dt) {
+    const std::uint8_t e = code(EtatAvion::ATTERRISSAGE);
+    size_t i = debut;
+
+#if defined(__AVX2__)
+    const __m256d vdt = _mm256_set1_pd(dt);
+    for (; i + 4 <= fin; i += 4) {
+        if (!contientEtat(&etat[i], e)) continue;
+        __m256d m = masqueEtat(&etat[i], e);
+
+        __m256d alt0 = _mm256_loadu_pd(&altitude[i]);
+        __m256d vd = _mm256_loadu_pd(&vitesseDescente[i]);
+        __m256d alt = plancherZero(_mm256_sub_pd(alt0, _mm256_mul_pd(_mm256_mul_pd(vd, _mm256_set1_pd(0.5)), vdt)));
+
+        __m256d v0 = _mm256_loadu_pd(&vitesse[i]);
+        __m256d v = plancherZero(_mm256_sub_pd(v0, _mm256_mul_pd(_mm256_set1_pd(15.0), vdt)));
+
+        __m256d pas = _mm256_mul_pd(v, vdt);
+        __m256d x0 = _mm256_loadu_pd(&x[i]);
+        __m256d y0 = _mm256_loadu_pd(&y[i]);
+        __m256d px = _mm256_add_pd(x0, _mm256_mul_pd(pas, _mm256_loadu_pd(&dirX[i])));
+        __m256d py = _mm256_add_pd(y0, _mm256_mul_pd(pas, _mm256_loadu_pd(&dirY[i])));
+
+        __m256d cx = _mm256_loadu_pd(&destX[i]);
+        __m256d cy = _mm256_loadu_pd(&destY[i]);
+        __m256d reste = distance4(px, py, cx, cy);
+        __m256d arrive = _mm256_and_pd(m, _mm256_cmp_pd(reste, _mm256_set1_pd(DISTANCE_ARRIVEE), _CMP_LT_OQ));
+
+        v = _mm256_blendv_pd(v, _mm256_setzero_pd(), arrive);
+        px = _mm256_blendv_pd(px, cx, arrive);
+        py = _mm256_blendv_pd(py, cy, arrive);
+        alt = _mm256_blendv_pd(alt, _mm256_loadu_pd(&destAltitude[i]), arrive);
+
+        ecrire(&vitesse[i], v0, v, m);
+        ecrire(&altitude[i], alt0, alt, m);
+        ecrire(&x[i], x0, px, m);
+        ecrire(&y[i], y0, py, m);
+        ecrireTransitions(&transition[i], arrive, EtatAvion::PARKING);
+    }
+#endif
+
+    for (; i < fin; i++) {
+        if (etat[i] != e) continue;
+
+        altitude[i] = altitude[i] - vitesseDescente[i] * 0.5 * dt;
+        if (altitude[i] < 0) altitude[i] = 0;
+
+        vitesse[i] = vitesse[i] - 15.0 * dt;
+        if (vitesse[i] < 0) vitesse[i] = 0;
+
+        double pas = vitesse[i] * dt;
+        x[i] = x[i] + pas * dirX[i];
+        y[i] = y[i] + pas * dirY[i];
+
+        if (distance(x[i], y[i], destX[i], destY[i]) < DISTANCE_ARRIVEE) {
+            vitesse[i] = 0.0;
+            x[i] = destX[i];
+            y[i] = destY[i];
+            altitude[i] = destAltitude[i];
+            transition[i] = code(EtatAvion::PARKING) + 1;
+        }
+    }
+}
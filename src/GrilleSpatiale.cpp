@@ -0,0 +1,83 @@
+#include "../include/GrilleSpatiale.h"
+
+GrilleSpatiale::GrilleSpatiale(double tailleCellule, double hauteurTranche)
+    : tailleCellule(tailleCellule > 0.0 ? tailleCellule : 10000.0),
+    hauteurTranche(hauteurTranche > 0.0 ? hauteurTranche : 1000.0),
+    generation(0) {
+}
+
+void GrilleSpatiale::mettreAJour(Avion* avion, const Position& pos, size_t rang) {
+    std::int64_t nouvelleCle = cle(pos);
+
+    auto it = index.find(avion);
+    if (it != index.end()) {
+        Localisation& loc = it->second;
+        loc.generation = generation;
+
+        // Toujours dans la même cellule : simple rafraîchissement
+        if (loc.cle == nouvelleCle) {
+            Entree& e = cellules[loc.cle][loc.place];
+            e.position = pos;
+            e.rang = rang;
+            return;
+        }
+
+        retirerDeCellule(loc.cle, loc.place);
+    }
+
+    std::vector<Entree>& cellule = cellules[nouvelleCle];
+    Entree e;
+    e.avion = avion;
+    e.position = pos;
+    e.rang = rang;
+    cellule.push_back(e);
+
+    Localisation loc;
+    loc.cle = nouvelleCle;
+    loc.place = cellule.size() - 1;
+    loc.generation = generation;
+    index[avion] = loc;
+}
+
+void GrilleSpatiale::retirerDeCellule(std::int64_t c, size_t place) {
+    auto itCellule = cellules.find(c);
+    if (itCellule == cellules.end()) return;
+
+    std::vector<Entree>& cellule = itCellule->second;
+
+    // Le dernier élément de la cellule prend la place libérée
+    if (place + 1 != cellule.size()) {
+        cellule[place] = cellule.back();
+        index[cellule[place].avion].place = place;
+    }
+    cellule.pop_back();
+
+    if (cellule.empty()) {
+        cellules.erase(itCellule);
+    }
+}
+
+void GrilleSpatiale::retirerAbsents() {
+    for (auto it = index.begin(); it != index.end();) {
+        if (it->second.generation != generation) {
+            retirerDeCellule(it->second.cle, it->second.place);
+            it = index.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void GrilleSpatiale::retirer(Avion* avion) {
+    auto it = index.find(avion);
+    if (it == index.end()) return;
+
+    retirerDeCellule(it->second.cle, it->second.place);
+    index.erase(it);
+}
+
+void GrilleSpatiale::vider() {
+    cellules.clear();
+    index.clear();
+}
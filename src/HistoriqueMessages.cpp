@@ -0,0 +1,424 @@
+#include "../include/HistoriqueMessages.h"
+#include "../include/Message.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    // Enregistrement dans un segment :
+    //   taille totale (u32), message brut, puis le texte libre d'un message AUTRE
+    const size_t TAILLE_EN_TETE = 4 + sizeof(Message);
+    const size_t TAILLE_ENREGISTREMENT_MAX = 0xFFFFFFFFu;     // Taille codée sur 32 bits
+
+    std::uint32_t longueurLibre(const Message& msg) {
+        return msg.type == TypeEvenement::AUTRE ? msg.charge.libre.longueur : 0;
+    }
+
+    void encoder(const Message& msg, size_t taille, char* sortie) {
+        std::uint32_t t = static_cast<std::uint32_t>(taille);
+        std::memcpy(sortie, &t, 4);
+        std::memcpy(sortie + 4, &msg, sizeof(Message));
+        if (longueurLibre(msg) > 0) {
+            std::memcpy(sortie + TAILLE_EN_TETE, msg.charge.libre.texte, msg.charge.libre.longueur);
+        }
+    }
+
+    // Décode l'enregistrement ; le texte libre pointe dans le segment
+    void decoder(const char* entree, Message& msg) {
+        std::memcpy(&msg, entree + 4, sizeof(Message));
+        if (msg.type == TypeEvenement::AUTRE) {
+            msg.charge.libre.texte = entree + TAILLE_EN_TETE;
+        }
+    }
+
+    std::int64_t horodatageEnregistrement(const char* entree) {
+        std::int64_t horodatage = 0;
+        std::memcpy(&horodatage, entree + 4 + offsetof(Message, timestamp), sizeof(horodatage));
+        return horodatage;
+    }
+
+    std::string repertoireTemporaire() {
+#ifdef _WIN32
+        char chemin[MAX_PATH + 1];
+        DWORD n = GetTempPathA(sizeof(chemin), chemin);
+        return (n > 0 && n <= MAX_PATH) ? std::string(chemin, n) : std::string(".");
+#else
+        const char* tmp = std::getenv("TMPDIR");
+        return (tmp != nullptr && tmp[0] != '\0') ? std::string(tmp) : std::string("/tmp");
+#endif
+    }
+
+    // Préfixe des segments ; l'identifiant du processus évite que deux
+    // simulations lancées dans le même répertoire écrasent leurs segments
+    std::string prefixeSegments(const std::string& repertoire, const std::string& nom) {
+        std::string chemin = repertoire.empty() ? repertoireTemporaire() : repertoire;
+        if (chemin.back() != '/' && chemin.back() != '\\') chemin += '/';
+#ifdef _WIN32
+        long pid = static_cast<long>(_getpid());
+#else
+        long pid = static_cast<long>(::getpid());
+#endif
+        return chemin + nom + "_" + std::to_string(pid);
+    }
+
+    // Bit du filtre d'avions d'un segment (256 bits)
+    size_t bitAvion(IdAvion id) {
+        return (id * 2654435761u) >> 24;
+    }
+
+    // Fichier projeté en mémoire
+    class Projection {
+    private:
+#ifdef _WIN32
+        HANDLE fichier;
+        HANDLE vue;
+#else
+        int fd;
+#endif
+        char* adresse;
+        size_t taille;
+
+        Projection(const Projection&);
+        Projection& operator=(const Projection&);
+
+    public:
+        Projection() :
+#ifdef _WIN32
+            fichier(INVALID_HANDLE_VALUE), vue(nullptr),
+#else
+            fd(-1),
+#endif
+            adresse(nullptr), taille(0) {
+        }
+
+        ~Projection() { fermer(); }
+
+        char* getAdresse() const { return adresse; }
+
+        // Création (fichier de taille fixe, lecture/écriture) ou lecture seule
+        bool ouvrir(const std::string& chemin, size_t t, bool creation) {
+            if (t == 0) return false;
+            taille = t;
+#ifdef _WIN32
+            fichier = CreateFileA(chemin.c_str(), creation ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                FILE_SHARE_READ, nullptr, creation ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (fichier == INVALID_HANDLE_VALUE) return false;
+            unsigned long long t64 = t;
+            vue = CreateFileMappingA(fichier, nullptr, creation ? PAGE_READWRITE : PAGE_READONLY,
+                static_cast<DWORD>(t64 >> 32), static_cast<DWORD>(t64 & 0xFFFFFFFFu), nullptr);
+            if (vue == nullptr) { fermer(); return false; }
+            adresse = static_cast<char*>(MapViewOfFile(vue, creation ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, t));
+            if (adresse == nullptr) { fermer(); return false; }
+#else
+            fd = ::open(chemin.c_str(), creation ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+            if (fd < 0) return false;
+            if (creation && ::ftruncate(fd, static_cast<off_t>(t)) != 0) { fermer(); return false; }
+            void* p = ::mmap(nullptr, t, creation ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) { fermer(); return false; }
+            adresse = static_cast<char*>(p);
+#endif
+            return true;
+        }
+
+        // Libère la projection ; tailleFinale > 0 : le fichier est tronqué
+        void fermer(size_t tailleFinale = 0) {
+#ifdef _WIN32
+            if (adresse != nullptr) UnmapViewOfFile(adresse);
+            if (vue != nullptr) CloseHandle(vue);
+            if (fichier != INVALID_HANDLE_VALUE) {
+                if (tailleFinale > 0) {
+                    LARGE_INTEGER position;
+                    position.QuadPart = static_cast<LONGLONG>(tailleFinale);
+                    if (SetFilePointerEx(fichier, position, nullptr, FILE_BEGIN)) SetEndOfFile(fichier);
+                }
+                CloseHandle(fichier);
+            }
+            vue = nullptr;
+            fichier = INVALID_HANDLE_VALUE;
+#else
+            if (adresse != nullptr) ::munmap(adresse, taille);
+            if (fd >= 0) {
+                if (tailleFinale > 0) {
+                    // En cas d'échec le fichier garde sa taille d'origine, sans conséquence
+                    int r = ::ftruncate(fd, static_cast<off_t>(tailleFinale));
+                    (void)r;
+                }
+                ::close(fd);
+            }
+            fd = -1;
+#endif
+            adresse = nullptr;
+            taille = 0;
+        }
+    };
+
+} // namespace
+
+static_assert(std::is_trivially_copyable<Message>::value, "Message est copié octet par octet dans les segments");
+
+// Segment de messages déversés. Le segment courant reste projeté en
+// écriture ; une fois plein il est tronqué à sa taille utile et n'est plus
+// projeté que le temps d'une lecture.
+class HistoriqueMessages::Segment {
+private:
+    std::string chemin;
+    Projection ecriture;
+    size_t capacite;
+    size_t utilises;
+    bool scelle;
+
+public:
+    size_t nombre;
+    std::int64_t horodatageMin;
+    std::int64_t horodatageMax;
+    std::uint64_t filtreAvions[4];
+
+    Segment(const std::string& chemin, size_t capacite)
+        : chemin(chemin), capacite(capacite), utilises(0), scelle(false),
+        nombre(0), horodatageMin(0), horodatageMax(0) {
+        std::memset(filtreAvions, 0, sizeof(filtreAvions));
+    }
+
+    ~Segment() {
+        ecriture.fermer();
+        std::remove(chemin.c_str());
+    }
+
+    bool ouvrir() { return ecriture.ouvrir(chemin, capacite, true); }
+
+    bool estScelle() const { return scelle; }
+    size_t placeRestante() const { return scelle ? 0 : capacite - utilises; }
+
+    void ajouter(const Message& msg, size_t taille) {
+        encoder(msg, taille, ecriture.getAdresse() + utilises);
+        utilises += taille;
+
+        std::int64_t h = msg.timestamp;
+        if (nombre == 0 || h < horodatageMin) horodatageMin = h;
+        if (nombre == 0 || h > horodatageMax) horodatageMax = h;
+        noterAvion(msg.avion);
+        if (msg.type != TypeEvenement::AUTRE) {
+            noterAvion(msg.charge.evenement.avion1);
+            noterAvion(msg.charge.evenement.avion2);
+        }
+        nombre++;
+    }
+
+    void sceller() {
+        if (scelle) return;
+        ecriture.fermer(utilises);
+        scelle = true;
+    }
+
+    void noterAvion(IdAvion id) {
+        if (id == RegistreAvions::ID_INVALIDE) return;
+        size_t bit = bitAvion(id);
+        filtreAvions[bit >> 6] |= 1ull << (bit & 63);
+    }
+
+    bool peutContenirAvion(IdAvion id) const {
+        size_t bit = bitAvion(id);
+        return (filtreAvions[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    // Appelle f(début d'enregistrement) sur chaque enregistrement
+    template <typename F>
+    void parcourir(F f) const {
+        if (utilises == 0) return;
+
+        Projection lecture;
+        const char* base = ecriture.getAdresse();
+        if (scelle) {
+            if (!lecture.ouvrir(chemin, utilises, false)) return;
+            base = lecture.getAdresse();
+        }
+
+        size_t position = 0;
+        while (position + TAILLE_EN_TETE <= utilises) {
+            std::uint32_t taille = 0;
+            std::memcpy(&taille, base + position, 4);
+            if (taille < TAILLE_EN_TETE) break;
+            f(base + position);
+            position += taille;
+        }
+    }
+};
+
+HistoriqueMessages::HistoriqueMessages(const std::string& nom, const ConfigurationHistorique& config)
+    : configuration(config),
+    prefixe(prefixeSegments(config.repertoire, nom)),
+    tete(0),
+    nombre(0),
+    numeroSegment(0),
+    nbEnregistres(0),
+    nbDeverses(0),
+    nbSupprimes(0),
+    nbRejetes(0) {
+    if (configuration.capaciteMemoire == 0) configuration.capaciteMemoire = 1;
+    if (configuration.nbSegmentsMax == 0) configuration.nbSegmentsMax = 1;
+    if (configuration.tailleSegment > TAILLE_ENREGISTREMENT_MAX) {
+        configuration.tailleSegment = TAILLE_ENREGISTREMENT_MAX;
+    }
+    anneau.reset(new Message[configuration.capaciteMemoire]);
+    textesLibres.reset(new std::string[configuration.capaciteMemoire]);
+}
+
+HistoriqueMessages::~HistoriqueMessages() {
+}
+
+void HistoriqueMessages::ajouter(const Message& msg) {
+    nbEnregistres++;
+
+    size_t place;
+    if (nombre == configuration.capaciteMemoire) {
+        // Anneau plein : le plus ancien part dans un segment
+        deverser(anneau[tete]);
+        place = tete;
+        tete = (tete + 1) % configuration.capaciteMemoire;
+    }
+    else {
+        place = (tete + nombre) % configuration.capaciteMemoire;
+        nombre++;
+    }
+
+    anneau[place] = msg;
+    if (msg.type == TypeEvenement::AUTRE) {
+        // Copie du texte libre dans la case (capacité réutilisée)
+        textesLibres[place].assign(msg.charge.libre.texte, msg.charge.libre.longueur);
+        anneau[place].charge.libre.texte = textesLibres[place].data();
+    }
+}
+
+HistoriqueMessages::Segment* HistoriqueMessages::segmentCourant(size_t tailleRequise) {
+    if (!segments.empty() && segments.back()->placeRestante() >= tailleRequise) {
+        return segments.back().get();
+    }
+    if (tailleRequise > configuration.tailleSegment) {
+        return nullptr;
+    }
+
+    if (!segments.empty()) {
+        segments.back()->sceller();
+    }
+
+    // Rétention : le plus ancien segment est supprimé
+    if (segments.size() >= configuration.nbSegmentsMax) {
+        nbSupprimes += segments.front()->nombre;
+        segments.erase(segments.begin());
+    }
+
+    std::unique_ptr<Segment> segment(new Segment(
+        prefixe + "_" + std::to_string(numeroSegment++) + ".seg", configuration.tailleSegment));
+    if (!segment->ouvrir()) {
+        return nullptr;
+    }
+    segments.push_back(std::move(segment));
+    return segments.back().get();
+}
+
+void HistoriqueMessages::deverser(const Message& msg) {
+    // Trop gros pour un segment : rejeté entier plutôt que tronqué
+    size_t taille = TAILLE_EN_TETE + longueurLibre(msg);
+    Segment* segment = segmentCourant(taille);
+    if (segment == nullptr) {
+        nbRejetes++;
+        return;
+    }
+    segment->ajouter(msg, taille);
+    nbDeverses++;
+}
+
+size_t HistoriqueMessages::parcourirIntervalle(long debut, long fin, const Visiteur& f) const {
+    size_t n = 0;
+    Message msg;
+
+    for (const auto& segment : segments) {
+        if (segment->nombre == 0 || segment->horodatageMax < debut || segment->horodatageMin > fin) {
+            continue;
+        }
+        segment->parcourir([&](const char* enregistrement) {
+            std::int64_t h = horodatageEnregistrement(enregistrement);
+            if (h < debut || h > fin) return;
+            decoder(enregistrement, msg);
+            f(msg);
+            n++;
+        });
+    }
+
+    for (size_t i = 0; i < nombre; i++) {
+        const Message& m = anneau[(tete + i) % configuration.capaciteMemoire];
+        if (m.timestamp >= debut && m.timestamp <= fin) {
+            f(m);
+            n++;
+        }
+    }
+    return n;
+}
+
+size_t HistoriqueMessages::parcourirAvion(IdAvion avion, const Visiteur& f) const {
+    size_t n = 0;
+    Message msg;
+
+    for (const auto& segment : segments) {
+        if (segment->nombre == 0 || !segment->peutContenirAvion(avion)) {
+            continue;
+        }
+        segment->parcourir([&](const char* enregistrement) {
+            decoder(enregistrement, msg);
+            if (!msg.concerne(avion)) return;
+            f(msg);
+            n++;
+        });
+    }
+
+    for (size_t i = 0; i < nombre; i++) {
+        const Message& m = anneau[(tete + i) % configuration.capaciteMemoire];
+        if (m.concerne(avion)) {
+            f(m);
+            n++;
+        }
+    }
+    return n;
+}
+
+size_t HistoriqueMessages::parcourirRecents(size_t n, const Visiteur& f) const {
+    if (n > nombre) n = nombre;
+    for (size_t i = nombre - n; i < nombre; i++) {
+        f(anneau[(tete + i) % configuration.capaciteMemoire]);
+    }
+    return n;
+}
+
+size_t HistoriqueMessages::taille() const {
+    size_t n = nombre;
+    for (const auto& segment : segments) {
+        n += segment->nombre;
+    }
+    return n;
+}
+
+StatistiquesHistorique HistoriqueMessages::getStatistiques() const {
+    StatistiquesHistorique s;
+    s.enregistres = nbEnregistres;
+    s.deverses = nbDeverses;
+    s.supprimes = nbSupprimes;
+    s.rejetes = nbRejetes;
+    s.enMemoire = nombre;
+    s.nbSegments = segments.size();
+    return s;
+}
@@ -0,0 +1,6 @@
+#include "../include/Horloge.h"
+
+Horloge& Horloge::systeme() {
+    static HorlogeReelle instance;
+    return instance;
+}
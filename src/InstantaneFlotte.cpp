@@ -0,0 +1,97 @@
+#include "../include/InstantaneFlotte.h"
+#include "../include/Flotte.h"
+#include "../include/Avion.h"
+
+EtatPublie InstantaneFlotte::evaluer(const EtatPublie& publie) const {
+    EtatPublie e = publie;
+    const CroisierePubliee& c = croisieres[&publie - &avions[0]];
+    if (c.plan) {
+        c.plan->evaluer(Flotte::abscisse(*c.plan, c.debut, c.vitesseCroisiere, temps),
+            e.x, e.y, e.dirX, e.dirY);
+    }
+    return e;
+}
+
+PublicationFlotte::PublicationFlotte()
+    : courant(-1),
+    nbPublications(0),
+    nbSautees(0) {
+    for (int i = 0; i < NB_TAMPONS; i++) {
+        lecteurs[i].store(0);
+    }
+}
+
+InstantaneFlotte* PublicationFlotte::preparer() {
+    int c = courant.load(std::memory_order_relaxed);
+    for (int i = 0; i < NB_TAMPONS; i++) {
+        // seq_cst : ordonné avec l'épinglage (incrément puis relecture de courant)
+        if (i != c && lecteurs[i].load() == 0) {
+            return &tampons[i];
+        }
+    }
+    nbSautees.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void PublicationFlotte::publier(InstantaneFlotte* instantane) {
+    instantane->numero = ++nbPublications;
+    courant.store(static_cast<int>(instantane - tampons));
+}
+
+int PublicationFlotte::epingler() const {
+    while (true) {
+        int c = courant.load();
+        if (c < 0) return -1;
+
+        lecteurs[c].fetch_add(1);
+        // Toujours le dernier publié : le rédacteur ne peut plus le choisir
+        if (courant.load() == c) {
+            return c;
+        }
+        lecteurs[c].fetch_sub(1);
+    }
+}
+
+void PublicationFlotte::liberer(int tampon) const {
+    if (tampon >= 0) {
+        lecteurs[tampon].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+LectureFlotte& LectureFlotte::operator=(LectureFlotte&& autre) {
+    if (this != &autre) {
+        liberer();
+        publication = autre.publication;
+        tampon = autre.tampon;
+        autre.tampon = -1;
+    }
+    return *this;
+}
+
+void LectureFlotte::liberer() {
+    if (publication != nullptr) {
+        publication->liberer(tampon);
+    }
+    tampon = -1;
+}
+
+EtatPublie LectureFlotte::etat(const Avion* avion) const {
+    if (tampon >= 0) {
+        const InstantaneFlotte& instantane = publication->getTampon(tampon);
+        const EtatPublie* e = instantane.trouver(avion->getId());
+        if (e != nullptr) return instantane.evaluer(*e);
+    }
+
+    EtatPublie e;
+    Position pos = avion->getPosition();
+    e.id = avion->getId();
+    e.etat = static_cast<std::uint8_t>(avion->getEtat());
+    e.x = pos.x;
+    e.y = pos.y;
+    e.altitude = pos.altitude;
+    e.vitesse = avion->getVitesse();
+    double v = avion->getVitesse();
+    e.dirX = v > 0.0 ? avion->getVitesseX() / v : 0.0;
+    e.dirY = v > 0.0 ? avion->getVitesseY() / v : 0.0;
+    return e;
+}
@@ -0,0 +1,330 @@
+#include "../include/JournalAsynchrone.h"
+#include "../include/Message.h"
+#include <chrono>
+#include <new>
+#include <cstdlib>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+
+    std::atomic<unsigned long> prochainIdentifiant(1);
+
+    size_t puissanceDeDeux(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Le new global de C++11 ne garantit pas l'alignement sur 64 octets
+    void* allouerAligne(size_t taille, size_t alignement) {
+#if defined(_WIN32)
+        void* p = _aligned_malloc(taille, alignement);
+#else
+        void* p = nullptr;
+        if (posix_memalign(&p, alignement, taille) != 0) p = nullptr;
+#endif
+        if (p == nullptr) throw std::bad_alloc();
+        return p;
+    }
+
+    void libererAligne(void* p) {
+#if defined(_WIN32)
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+} // namespace
+
+struct JournalAsynchrone::Enregistrement {
+    Message msg;
+    std::string texte;      // Copie du texte libre d'un message AUTRE
+};
+
+// Anneau d'un fichier : un producteur à la fois (sous producteurs) et un
+// consommateur (le rédacteur). Les cellules sont réutilisées : le texte
+// libre garde sa capacité d'un tour à l'autre.
+class JournalAsynchrone::Anneau {
+private:
+    std::vector<Enregistrement> cellules;
+    size_t masque;
+    alignas(64) std::atomic<size_t> queue;     // Écrit par le producteur
+    alignas(64) std::atomic<size_t> tete;      // Écrit par le rédacteur
+
+public:
+    std::mutex producteurs;                     // Pris par ecrire() autour de deposer()
+
+    // Cellules de tête et de queue sur leurs propres lignes de cache
+    static void* operator new(size_t taille) { return allouerAligne(taille, 64); }
+    static void operator delete(void* p) { libererAligne(p); }
+
+    explicit Anneau(size_t capacite)
+        : cellules(puissanceDeDeux(capacite)),
+        masque(cellules.size() - 1),
+        queue(0),
+        tete(0) {
+    }
+
+    // Producteur : faux si l'anneau est plein
+    bool deposer(const Message& msg) {
+        size_t q = queue.load(std::memory_order_relaxed);
+        if (q - tete.load(std::memory_order_acquire) >= cellules.size()) {
+            return false;
+        }
+
+        Enregistrement& e = cellules[q & masque];
+        e.msg = msg;
+        if (msg.type == TypeEvenement::AUTRE) {
+            // Le texte source ne vit que le temps du cycle du producteur
+            e.texte.assign(msg.charge.libre.texte, msg.charge.libre.longueur);
+        }
+        queue.store(q + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producteur : vrai si l'anneau est au moins à moitié plein
+    bool estCharge() const {
+        return queue.load(std::memory_order_relaxed) - tete.load(std::memory_order_relaxed) >=
+            cellules.size() / 2;
+    }
+
+    // Consommateur : appelle f(Enregistrement&) sur tout ce qui a été publié
+    template <typename F>
+    size_t relever(F f) {
+        size_t t = tete.load(std::memory_order_relaxed);
+        size_t q = queue.load(std::memory_order_acquire);
+        for (size_t i = t; i != q; i++) {
+            f(cellules[i & masque]);
+        }
+        tete.store(q, std::memory_order_release);
+        return q - t;
+    }
+};
+
+JournalAsynchrone::JournalAsynchrone(const ConfigurationJournal& configuration)
+    : configuration(configuration),
+    identifiant(prochainIdentifiant.fetch_add(1)),
+    bloquer(configuration.politique == PolitiqueJournal::BLOQUER),
+    reveil(false),
+    arret(false),
+    demandesVidage(0),
+    vidagesEffectues(0),
+    nbEcrits(0),
+    nbAbandonnes(0),
+    nbAttentes(0),
+    nbLots(0) {
+    redacteur = std::thread(&JournalAsynchrone::boucleRedacteur, this);
+}
+
+JournalAsynchrone::~JournalAsynchrone() {
+    {
+        std::lock_guard<std::mutex> lock(mtxRedacteur);
+        arret = true;
+    }
+    cvRedacteur.notify_all();
+    if (redacteur.joinable()) {
+        redacteur.join();
+    }
+
+    // Dernier passage : plus aucun autre consommateur
+    relever();
+
+    std::lock_guard<std::mutex> lock(mtxFlux);
+    for (auto& f : flux) {
+        if (f && f->fichier.is_open()) {
+            f->fichier << "]\n";
+            f->fichier.close();
+        }
+    }
+}
+
+JournalAsynchrone& JournalAsynchrone::globale() {
+    static JournalAsynchrone journal;
+    return journal;
+}
+
+void JournalAsynchrone::configurer(const ConfigurationJournal& nouvelle) {
+    {
+        std::lock_guard<std::mutex> lockAnneaux(mtxAnneaux);
+        std::lock_guard<std::mutex> lock(mtxRedacteur);
+        configuration = nouvelle;
+        if (configuration.intervalleVidageMs == 0) configuration.intervalleVidageMs = 1;
+        if (configuration.capaciteAnneau == 0) configuration.capaciteAnneau = 2;
+    }
+    bloquer.store(nouvelle.politique == PolitiqueJournal::BLOQUER);
+    cvRedacteur.notify_all();
+}
+
+ConfigurationJournal JournalAsynchrone::getConfiguration() const {
+    std::lock_guard<std::mutex> lock(mtxRedacteur);
+    return configuration;
+}
+
+JournalAsynchrone::Anneau& JournalAsynchrone::anneauDe(int idFlux) {
+    // Anneaux déjà vus par ce thread, retrouvés sans verrou
+    thread_local unsigned long journalCache = 0;
+    thread_local std::vector<Anneau*> cache;
+
+    if (journalCache != identifiant) {
+        cache.clear();
+        journalCache = identifiant;
+    }
+    size_t f = static_cast<size_t>(idFlux);
+    if (f < cache.size() && cache[f] != nullptr) {
+        return *cache[f];
+    }
+
+    std::lock_guard<std::mutex> lock(mtxAnneaux);
+    if (f >= anneaux.size()) anneaux.resize(f + 1);
+    if (!anneaux[f]) {
+        anneaux[f].reset(new Anneau(configuration.capaciteAnneau));
+    }
+    if (f >= cache.size()) cache.resize(f + 1, nullptr);
+    cache[f] = anneaux[f].get();
+    return *cache[f];
+}
+
+int JournalAsynchrone::ouvrir(const std::string& chemin) {
+    std::unique_ptr<Flux> f(new Flux());
+    f->fichier.open(chemin, std::ios::app);
+    if (!f->fichier.is_open()) {
+        return -1;
+    }
+    f->fichier << "[\n";
+    f->fichier.flush();
+
+    std::lock_guard<std::mutex> lock(mtxFlux);
+    flux.push_back(std::move(f));
+    return static_cast<int>(flux.size() - 1);
+}
+
+void JournalAsynchrone::fermer(int idFlux) {
+    if (idFlux < 0) return;
+
+    vider();
+
+    std::lock_guard<std::mutex> lock(mtxFlux);
+    if (static_cast<size_t>(idFlux) < flux.size() && flux[idFlux]) {
+        flux[idFlux]->fichier << "]\n";
+        flux[idFlux]->fichier.close();
+        flux[idFlux].reset();
+    }
+}
+
+bool JournalAsynchrone::ecrire(int idFlux, const Message& msg) {
+    if (idFlux < 0) return false;
+
+    Anneau& anneau = anneauDe(idFlux);
+    std::lock_guard<std::mutex> lock(anneau.producteurs);
+
+    if (!anneau.deposer(msg)) {
+        if (!bloquer.load(std::memory_order_relaxed)) {
+            nbAbandonnes.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Politique BLOQUER : réveiller le rédacteur et attendre une place
+        nbAttentes.fetch_add(1, std::memory_order_relaxed);
+        do {
+            reveil.store(true, std::memory_order_relaxed);
+            cvRedacteur.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } while (!anneau.deposer(msg));
+    }
+
+    // Réveil anticipé du rédacteur pour éviter de remplir l'anneau
+    if (anneau.estCharge()) {
+        reveil.store(true, std::memory_order_relaxed);
+        cvRedacteur.notify_one();
+    }
+    return true;
+}
+
+void JournalAsynchrone::vider() {
+    std::unique_lock<std::mutex> lock(mtxRedacteur);
+    if (arret) return;
+
+    unsigned long ticket = ++demandesVidage;
+    cvRedacteur.notify_all();
+    cvVidage.wait(lock, [this, ticket]() { return vidagesEffectues >= ticket || arret; });
+}
+
+void JournalAsynchrone::boucleRedacteur() {
+    std::unique_lock<std::mutex> lock(mtxRedacteur);
+
+    while (true) {
+        cvRedacteur.wait_for(lock, std::chrono::milliseconds(configuration.intervalleVidageMs),
+            [this]() {
+                return arret || demandesVidage != vidagesEffectues ||
+                    reveil.load(std::memory_order_relaxed);
+            });
+
+        unsigned long demande = demandesVidage;
+        bool fin = arret;
+        reveil.store(false, std::memory_order_relaxed);
+
+        lock.unlock();
+        relever();
+        lock.lock();
+
+        vidagesEffectues = demande;
+        cvVidage.notify_all();
+
+        if (fin) break;
+    }
+}
+
+void JournalAsynchrone::relever() {
+    std::vector<Anneau*> aRelever;         // Indexé par identifiant de flux
+    {
+        std::lock_guard<std::mutex> lock(mtxAnneaux);
+        aRelever.reserve(anneaux.size());
+        for (auto& a : anneaux) {
+            aRelever.push_back(a.get());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mtxFlux);
+
+    // Sérialisation dans le tampon de chaque fichier, dans l'ordre de son
+    // anneau (fichier fermé : les enregistrements sont relevés et perdus)...
+    unsigned long long n = 0;
+    for (size_t i = 0; i < aRelever.size(); i++) {
+        if (aRelever[i] == nullptr) continue;
+
+        Flux* f = i < flux.size() ? flux[i].get() : nullptr;
+        aRelever[i]->relever([f, &n](Enregistrement& e) {
+            if (f == nullptr) return;
+            std::string& tampon = f->tampon;
+            if (e.msg.type == TypeEvenement::AUTRE) {
+                e.msg.charge.libre.texte = e.texte.data();
+            }
+            e.msg.ajouterJSON(tampon);
+            tampon.append(",\n");
+            n++;
+        });
+    }
+
+    // ...puis une seule écriture et un seul flush par fichier
+    for (auto& f : flux) {
+        if (!f || f->tampon.empty()) continue;
+        f->fichier.write(f->tampon.data(), static_cast<std::streamsize>(f->tampon.size()));
+        f->fichier.flush();
+        f->tampon.clear();
+        nbLots.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    nbEcrits.fetch_add(n, std::memory_order_relaxed);
+}
+
+StatistiquesJournal JournalAsynchrone::getStatistiques() const {
+    StatistiquesJournal s;
+    s.ecrits = nbEcrits.load(std::memory_order_relaxed);
+    s.abandonnes = nbAbandonnes.load(std::memory_order_relaxed);
+    s.attentes = nbAttentes.load(std::memory_order_relaxed);
+    s.lots = nbLots.load(std::memory_order_relaxed);
+    return s;
+}
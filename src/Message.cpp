@@ -0,0 +1,232 @@
+#include "../include/Message.h"
+
+namespace {
+
+    void ajouterEntier(std::string& sortie, double v) {
+        sortie.append(std::to_string(static_cast<int>(v)));
+    }
+
+} // namespace
+
+const char* nomTypeEvenement(TypeEvenement type) {
+    switch (type) {
+    case TypeEvenement::AJOUT_AEROPORT: return "AJOUT_AEROPORT";
+    case TypeEvenement::AJOUT_ROUTE: return "AJOUT_ROUTE";
+    case TypeEvenement::ERREUR_ROUTE: return "ERREUR_ROUTE";
+    case TypeEvenement::ERREUR_VOL: return "ERREUR_VOL";
+    case TypeEvenement::VOL_RETARDE: return "VOL_RETARDE";
+    case TypeEvenement::VOL_CREE: return "VOL_CREE";
+    case TypeEvenement::CONFLIT_DETECTE: return "CONFLIT_DETECTE";
+    case TypeEvenement::CONFLIT_PREVU: return "CONFLIT_PREVU";
+    case TypeEvenement::AEROPORT_SATURE: return "AEROPORT_SATURE";
+    case TypeEvenement::TRANSFERT_APP: return "TRANSFERT_APP";
+    case TypeEvenement::RECUPERATION_AVION: return "RECUPERATION_AVION";
+    case TypeEvenement::AVION_DEJA_PRESENT: return "AVION_DEJA_PRESENT";
+    case TypeEvenement::AVION_RECU_APP: return "AVION_RECU_APP";
+    case TypeEvenement::AVION_AJOUTE: return "AVION_AJOUTE";
+    case TypeEvenement::AVION_RETIRE: return "AVION_RETIRE";
+    case TypeEvenement::ENTREE_ZONE_APPROCHE: return "ENTREE_ZONE_APPROCHE";
+    case TypeEvenement::TRAJECTOIRE_ASSIGNEE: return "TRAJECTOIRE_ASSIGNEE";
+    case TypeEvenement::DEMANDE_NOUVEL_APP: return "DEMANDE_NOUVEL_APP";
+    case TypeEvenement::TRANSFERT_CCR: return "TRANSFERT_CCR";
+    case TypeEvenement::INIT_PARKINGS: return "INIT_PARKINGS";
+    case TypeEvenement::AUTORISATION_ATTERRISSAGE: return "AUTORISATION_ATTERRISSAGE";
+    case TypeEvenement::LIBERATION_PARKING: return "LIBERATION_PARKING";
+    case TypeEvenement::ROULAGE_VERS_PARKING: return "ROULAGE_VERS_PARKING";
+    case TypeEvenement::AVION_STATIONNE: return "AVION_STATIONNE";
+    case TypeEvenement::AUTORISATION_DECOLLAGE: return "AUTORISATION_DECOLLAGE";
+    case TypeEvenement::POIGNEE_PERIMEE: return "POIGNEE_PERIMEE";
+    case TypeEvenement::PISTE_OCCUPEE: return "PISTE_OCCUPEE";
+    case TypeEvenement::PISTE_LIBEREE: return "PISTE_LIBEREE";
+    case TypeEvenement::URGENCE_PRIORISEE: return "URGENCE_PRIORISEE";
+    default: return "AUTRE";
+    }
+}
+
+void ajouterContenu(std::string& s, TypeEvenement type, const std::string& a1,
+    const std::string& a2, const std::string& t1, const std::string& t2,
+    double v1, double v2) {
+
+    switch (type) {
+    case TypeEvenement::AJOUT_AEROPORT:
+        s.append("Aéroport ").append(t1).append(" ajouté au réseau");
+        break;
+    case TypeEvenement::AJOUT_ROUTE:
+        s.append("Route ").append(t1).append(" -> ").append(t2).append(" ajoutée (");
+        ajouterEntier(s, v1);
+        s.append(" km)");
+        break;
+    case TypeEvenement::ERREUR_ROUTE:
+        s.append("Aéroport inexistant pour la route ").append(t1).append(" -> ").append(t2);
+        break;
+    case TypeEvenement::ERREUR_VOL:
+        s.append("Impossible de créer le vol ").append(t1).append(" - aéroport inexistant");
+        break;
+    case TypeEvenement::VOL_RETARDE:
+        s.append("Vol ").append(t1).append(" retardé - capacité ").append(t2).append(" saturée");
+        break;
+    case TypeEvenement::VOL_CREE:
+        s.append("Vol ").append(a1).append(" créé: ").append(t1).append(" -> ").append(t2);
+        break;
+    case TypeEvenement::CONFLIT_DETECTE:
+        s.append("Conflit entre ").append(a1).append(" et ").append(a2).append(" - distance: ");
+        ajouterEntier(s, v1);
+        s.append("m");
+        break;
+    case TypeEvenement::CONFLIT_PREVU:
+        s.append("Conflit prévu entre ").append(a1).append(" et ").append(a2).append(" dans ");
+        ajouterEntier(s, v1);
+        s.append("s - distance min: ");
+        ajouterEntier(s, v2);
+        s.append("m");
+        break;
+    case TypeEvenement::AEROPORT_SATURE:
+        s.append("Aéroport ").append(t1).append(" à capacité maximale (");
+        ajouterEntier(s, v1);
+        s.append("/");
+        ajouterEntier(s, v2);
+        s.append(")");
+        break;
+    case TypeEvenement::TRANSFERT_APP:
+        s.append("Avion ").append(a1).append(" transféré à l'APP ").append(t1);
+        break;
+    case TypeEvenement::RECUPERATION_AVION:
+        s.append("Avion ").append(a1).append(" récupéré en croisière");
+        break;
+    case TypeEvenement::AVION_DEJA_PRESENT:
+        s.append("Avion ").append(a1).append(" déjà sous contrôle CCR");
+        break;
+    case TypeEvenement::AVION_RECU_APP:
+        s.append("Avion ").append(a1).append(" reçu depuis APP ").append(t1);
+        break;
+    case TypeEvenement::AVION_AJOUTE:
+        s.append("Avion ").append(a1).append(" ajouté en approche");
+        break;
+    case TypeEvenement::AVION_RETIRE:
+        s.append("Avion ").append(a1).append(" retiré de l'approche");
+        break;
+    case TypeEvenement::ENTREE_ZONE_APPROCHE:
+        s.append("Avion ").append(a1).append(" entre en zone d'approche, niveau ");
+        ajouterEntier(s, v1);
+        break;
+    case TypeEvenement::TRAJECTOIRE_ASSIGNEE:
+        s.append("Avion ").append(a1).append(" - Trajectoire circulaire rayon ");
+        ajouterEntier(s, v1);
+        s.append("m, altitude ");
+        ajouterEntier(s, v2);
+        s.append("m");
+        break;
+    case TypeEvenement::DEMANDE_NOUVEL_APP:
+        s.append("Zone saturée, demande d'un nouveau contrôleur d'approche");
+        break;
+    case TypeEvenement::TRANSFERT_CCR:
+        s.append("Avion ").append(a1).append(" transféré au CCR");
+        break;
+    case TypeEvenement::INIT_PARKINGS:
+        s.append("Initialisation de ");
+        ajouterEntier(s, v1);
+        s.append(" parkings");
+        break;
+    case TypeEvenement::AUTORISATION_ATTERRISSAGE:
+        s.append("Avion ").append(a1).append(" autorisé à atterrir");
+        break;
+    case TypeEvenement::LIBERATION_PARKING:
+        s.append("Parking ").append(t1).append(" libéré");
+        break;
+    case TypeEvenement::ROULAGE_VERS_PARKING:
+        s.append("Avion ").append(a1).append(" roule vers ").append(t1);
+        break;
+    case TypeEvenement::AVION_STATIONNE:
+        s.append("Avion ").append(a1).append(" stationné");
+        break;
+    case TypeEvenement::AUTORISATION_DECOLLAGE:
+        s.append("Avion ").append(a1).append(" autorisé à rouler vers la piste");
+        break;
+    case TypeEvenement::POIGNEE_PERIMEE:
+        s.append("Avion ").append(a1).append(" rendu au pool, retiré du contrôle");
+        break;
+    case TypeEvenement::PISTE_OCCUPEE:
+        s.append("Piste occupée par ").append(a1).append(" jusqu'à t=");
+        ajouterEntier(s, v1);
+        s.append("s");
+        break;
+    case TypeEvenement::PISTE_LIBEREE:
+        s.append("Piste libérée");
+        break;
+    case TypeEvenement::URGENCE_PRIORISEE:
+        s.append("Avion ").append(a1).append(" en urgence, prioritaire à l'atterrissage (");
+        ajouterEntier(s, v1);
+        s.append(" avions en séquence)");
+        break;
+    default:
+        s.append(t1);
+        break;
+    }
+}
+
+std::string formaterContenu(TypeEvenement type, const std::string& a1,
+    const std::string& a2, const std::string& t1, const std::string& t2,
+    double v1, double v2) {
+    std::string contenu;
+    ajouterContenu(contenu, type, a1, a2, t1, t2, v1, v2);
+    return contenu;
+}
+
+Message::Message()
+    : type(TypeEvenement::AUTRE),
+    expediteur(JOURNAL),
+    destinataire(JOURNAL),
+    avion(RegistreAvions::ID_INVALIDE),
+    timestamp(0) {
+    charge.evenement.avion1 = RegistreAvions::ID_INVALIDE;
+    charge.evenement.avion2 = RegistreAvions::ID_INVALIDE;
+    charge.evenement.texte1 = TableTextes::AUCUN;
+    charge.evenement.texte2 = TableTextes::AUCUN;
+    charge.evenement.valeur1 = 0.0;
+    charge.evenement.valeur2 = 0.0;
+}
+
+bool Message::concerne(IdAvion id) const {
+    if (avion == id) return true;
+    if (type == TypeEvenement::AUTRE) return false;
+    return charge.evenement.avion1 == id || charge.evenement.avion2 == id;
+}
+
+std::string Message::toJSON() const {
+    std::string json;
+    ajouterJSON(json);
+    return json;
+}
+
+void Message::ajouterJSON(std::string& sortie) const {
+    const RegistreAvions& registre = RegistreAvions::globale();
+    const TableTextes& table = TableTextes::globale();
+    static const std::string vide;
+
+    sortie.append("{\"expediteur\":\"").append(registre.getNomControleur(expediteur));
+    sortie.append("\",\"destinataire\":\"");
+    if (destinataire == JOURNAL) sortie.append("LOG");
+    else sortie.append(registre.getNomControleur(destinataire));
+
+    sortie.append("\",\"type\":\"");
+    if (type == TypeEvenement::AUTRE) sortie.append(table.get(charge.libre.action));
+    else sortie.append(nomTypeEvenement(type));
+
+    sortie.append("\",\"avionId\":\"");
+    if (avion != RegistreAvions::ID_INVALIDE) sortie.append(registre.getNom(avion));
+
+    sortie.append("\",\"contenu\":\"");
+    if (type == TypeEvenement::AUTRE) {
+        if (charge.libre.longueur > 0) sortie.append(charge.libre.texte, charge.libre.longueur);
+    }
+    else {
+        const ChargeEvenement& e = charge.evenement;
+        ajouterContenu(sortie, type,
+            e.avion1 != RegistreAvions::ID_INVALIDE ? registre.getNom(e.avion1) : vide,
+            e.avion2 != RegistreAvions::ID_INVALIDE ? registre.getNom(e.avion2) : vide,
+            table.get(e.texte1), table.get(e.texte2), e.valeur1, e.valeur2);
+    }
+
+    sortie.append("\",\"timestamp\":").append(std::to_string(timestamp));
+    sortie.push_back('}');
+}
@@ -0,0 +1,512 @@
+#include "../include/Ordonnanceur.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+Ordonnanceur::Ordonnanceur(size_t nbThreads, double frequence,
+    double facteurTemps, size_t tailleLot, Flotte& flotte)
+    : flotte(flotte),
+    pool(nbThreads),
+    horlogeAvionsPrecedente(&Avion::getHorloge()),
+    running(false),
+    frequence(frequence > 0.0 ? frequence : 60.0),
+    facteurTemps(facteurTemps),
+    tailleLot(tailleLot > 0 ? tailleLot : 1),
+    nbTicks(0),
+    nbTicksEnRetard(0) {
+    // L'horloge appartient à l'ordonnanceur : les avions ne la gardent pas
+    // au-delà de sa destruction
+    Avion::setHorloge(horloge);
+}
+
+Ordonnanceur::~Ordonnanceur() {
+    arreter();
+
+    // Du dernier au premier : aucun avion n'est déplacé par les retraits
+    // (la destruction prend le verrou de la flotte)
+    while (true) {
+        Avion* avion = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(flotte.getMutex());
+            if (flotte.taille() == 0) break;
+            avion = flotte.getAvion(flotte.taille() - 1);
+        }
+        detruire(avion);
+    }
+
+    if (&Avion::getHorloge() == &horloge) {
+        Avion::setHorloge(*horlogeAvionsPrecedente);
+    }
+}
+
+void Ordonnanceur::detruire(Avion* avion) {
+    if (avion->getPoignee().estNulle()) {
+        delete avion;
+    }
+    else {
+        PoolAvions::globale().liberer(avion->getPoignee());
+    }
+}
+
+bool Ordonnanceur::ajouterAvion(Avion* avion) {
+    if (avion == nullptr) return false;
+
+    std::lock_guard<std::mutex> lock(flotte.getMutex());
+    size_t i = avion->getIndice();
+    if (i < flotte.taille() && flotte.getAvion(i) == avion) {
+        return true;
+    }
+
+    std::cerr << "[Ordonnanceur] " << avion->getNom() << " n'est pas dans la flotte de l'ordonnanceur\n";
+    return false;
+}
+
+size_t Ordonnanceur::getNbAvions() const {
+    std::lock_guard<std::mutex> lock(flotte.getMutex());
+    return flotte.taille();
+}
+
+void Ordonnanceur::ajouterControleur(ControleurBase* controleur, double periode, int vague) {
+    if (controleur == nullptr) return;
+
+    ControleurCadence c;
+    c.controleur = controleur;
+    c.periode = periode > 0.0 ? periode : getPas();
+    c.prochainCycle = horloge.maintenant();
+    c.vague = vague;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    c.indice = controleurs.size();
+    controleurs.push_back(c);
+}
+
+StatistiquesCadence Ordonnanceur::getStatistiques(const ControleurBase* controleur) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& c : controleurs) {
+        if (c.controleur == controleur) return c.statistiques;
+    }
+    return StatistiquesCadence();
+}
+
+void Ordonnanceur::reporterStatistiques(const std::vector<ControleurCadence>& copies) {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const auto& c : copies) {
+        controleurs[c.indice].statistiques = c.statistiques;
+    }
+}
+
+void Ordonnanceur::tick(double dt) {
+    // Pas en phases, au résultat indépendant du nombre de threads :
+    //   1. décisions : contrôleurs échus, vague par vague (en parallèle au
+    //      sein d'une vague), sur l'instantané publié au pas précédent
+    //   2. calcul parallèle : noyaux cinématiques (chaque avion ne lit et
+    //      n'écrit que ses propres colonnes)
+    //   3. validation séquentielle dans l'ordre des indices : transitions et
+    //      phases au sol (tirages aléatoires, créations, journaux), puis vols
+    //      terminés rendus au pool et avions demandés par les contrôleurs créés
+    //   4. publication de l'instantané, puis avance de l'horloge
+    if (flotte.getNbPublications() == 0) {
+        std::lock_guard<std::mutex> lock(flotte.getMutex());
+        flotte.publier(horloge.maintenant());
+    }
+
+    // Hors du verrou de la flotte ; un contrôleur ne crée pas d'avion
+    // pendant son cycle, il le demande (creerAvionsDemandes)
+    cadencerControleurs();
+
+    {
+        std::lock_guard<std::mutex> lock(flotte.getMutex());
+
+        Flotte& f = flotte;
+        const double finPas = horloge.maintenant() + dt;
+        pool.paralleliser(f.taille(), tailleLot,
+            [&f, dt, finPas](size_t debut, size_t fin, size_t) {
+                f.avancerCinematique(debut, fin, dt, finPas);
+            });
+
+        for (size_t i = 0; i < f.taille(); i++) {
+            Avion* avion = f.getAvion(i);
+            avion->finaliserPas(dt);
+            if (avion->estTermine()) volsTermines.push_back(avion);
+        }
+    }
+
+    // La destruction et la création d'un avion prennent le verrou de la flotte
+    retirerVolsTermines();
+    creerAvionsDemandes();
+    {
+        std::lock_guard<std::mutex> lock(flotte.getMutex());
+        flotte.publier(horloge.maintenant() + dt);
+    }
+
+    horloge.avancer(dt);
+
+    nbTicks++;
+}
+
+void Ordonnanceur::retirerVolsTermines() {
+    if (volsTermines.empty()) return;
+
+    for (auto* avion : volsTermines) {
+        // Quitte la flotte en étant détruit : les contrôleurs l'oublient d'eux-mêmes
+        detruire(avion);
+    }
+    volsTermines.clear();
+}
+
+size_t Ordonnanceur::creerAvionsDemandes() {
+    // Entrés en croisière à l'instant de la décision : le pas publié
+    // ensuite les montre déjà en route
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t crees = 0;
+    for (const auto& c : controleurs) {
+        crees += c.controleur->creerAvionsDemandes();
+    }
+    return crees;
+}
+
+void Ordonnanceur::cadencerControleurs() {
+    std::vector<ControleurCadence> echus;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        double t = horloge.maintenant();
+        for (auto& c : controleurs) {
+            if (t >= c.prochainCycle) {
+                c.prochainCycle += c.periode;
+                if (c.prochainCycle < t) {
+                    // Échéances dépassées pendant le retard : comptées, pas rattrapées
+                    c.statistiques.cyclesManques += static_cast<unsigned long long>(
+                        std::ceil((t - c.prochainCycle) / c.periode));
+                    c.prochainCycle = t + c.periode;
+                }
+                echus.push_back(c);
+            }
+        }
+    }
+    if (echus.empty()) return;
+
+    std::vector<ControleurCadence*> aExecuter;
+    for (auto& c : echus) {
+        aExecuter.push_back(&c);
+    }
+    executerVagues(aExecuter);
+    reporterStatistiques(echus);
+}
+
+void Ordonnanceur::afficherCadences() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (controleurs.empty()) return;
+
+    unsigned long long cycles = 0;
+    unsigned long long manques = 0;
+    const ControleurCadence* plusLong = &controleurs[0];
+    for (const auto& c : controleurs) {
+        cycles += c.statistiques.cycles;
+        manques += c.statistiques.cyclesManques;
+        if (c.statistiques.dureeMax > plusLong->statistiques.dureeMax) plusLong = &c;
+    }
+    std::cout << "[Ordonnanceur] Controleurs : " << cycles << " cycles, " << manques
+        << " echeances manquees, plus long cycle " << plusLong->statistiques.dureeMax * 1000.0
+        << " ms (" << plusLong->controleur->getNom() << ")\n";
+}
+
+void Ordonnanceur::executerVagues(std::vector<ControleurCadence*>& aExecuter) {
+    typedef std::chrono::steady_clock HorlogeMurale;
+
+    // Chaque cadence n'est écrite que par le thread qui exécute son cycle
+    auto executer = [](ControleurCadence* c) {
+        HorlogeMurale::time_point debut = HorlogeMurale::now();
+        c->controleur->executerCycle();
+        std::chrono::duration<double> duree = HorlogeMurale::now() - debut;
+
+        c->statistiques.cycles++;
+        if (duree.count() > c->statistiques.dureeMax) c->statistiques.dureeMax = duree.count();
+    };
+
+    // Tri stable : l'ordre d'ajout est conservé au sein d'une vague
+    std::stable_sort(aExecuter.begin(), aExecuter.end(),
+        [](const ControleurCadence* a, const ControleurCadence* b) { return a->vague < b->vague; });
+
+    size_t debutVague = 0;
+    while (debutVague < aExecuter.size()) {
+        size_t finVague = debutVague + 1;
+        while (finVague < aExecuter.size() && aExecuter[finVague]->vague == aExecuter[debutVague]->vague) {
+            finVague++;
+        }
+
+        if (finVague - debutVague == 1) {
+            executer(aExecuter[debutVague]);
+        }
+        else {
+            ControleurCadence* const* vague = &aExecuter[debutVague];
+            pool.paralleliser(finVague - debutVague, 1,
+                [vague, &executer](size_t debut, size_t fin, size_t) {
+                    for (size_t i = debut; i < fin; i++) {
+                        executer(vague[i]);
+                    }
+                });
+        }
+        debutVague = finVague;
+    }
+}
+
+void Ordonnanceur::demarrer() {
+    bool expected = false;
+    if (!running.compare_exchange_strong(expected, true)) {
+        return;
+    }
+
+    threadBoucle = std::thread(&Ordonnanceur::boucle, this);
+}
+
+void Ordonnanceur::arreter() {
+    bool expected = true;
+    if (!running.compare_exchange_strong(expected, false)) {
+        return;
+    }
+
+    if (threadBoucle.joinable()) {
+        threadBoucle.join();
+    }
+}
+
+void Ordonnanceur::executerSansAffichage(double dureeSimulee) {
+    typedef std::chrono::steady_clock HorlogeMurale;
+
+    const double dt = getPas();
+    const double fin = horloge.maintenant() + dureeSimulee;
+
+    std::cout << "[Ordonnanceur] Sans affichage : " << dureeSimulee << " s simulees, "
+        << getNbAvions() << " avions, " << pool.getNbThreads() << " threads\n";
+
+    HorlogeMurale::time_point debut = HorlogeMurale::now();
+
+    while (horloge.maintenant() < fin) {
+        tick(dt);
+    }
+
+    std::chrono::duration<double> ecoule = HorlogeMurale::now() - debut;
+    std::cout << "[Ordonnanceur] " << nbTicks.load() << " ticks en " << ecoule.count()
+        << " s (x" << (ecoule.count() > 0.0 ? dureeSimulee / ecoule.count() : 0.0)
+        << " temps reel)\n";
+    afficherCadences();
+
+    std::ios::fmtflags format = std::cout.flags();
+    std::cout << "[Ordonnanceur] Empreinte de l'etat final : " << std::hex
+        << getEmpreinte() << "\n";
+    std::cout.flags(format);
+}
+
+void Ordonnanceur::executerEvenements(double dureeSimulee) {
+    typedef std::chrono::steady_clock HorlogeMurale;
+
+    // Tous les instants sont des multiples du pas : les réveils tombent sur
+    // la même grille que le mode à pas fixe
+    const double dt = getPas();
+    const std::uint64_t debutTick = static_cast<std::uint64_t>(std::floor(horloge.maintenant() / dt + 0.5));
+    const std::uint64_t finTick = debutTick + static_cast<std::uint64_t>(std::ceil(dureeSimulee / dt));
+
+    std::cout << "[Ordonnanceur] Mode evenementiel : " << dureeSimulee << " s simulees, "
+        << getNbAvions() << " avions\n";
+
+    CalendrierEvenements calendrier(4096, debutTick);
+    std::vector<ReveilPlanifie> echus;
+    std::vector<size_t> aExecuter;
+
+    // Contrôleurs : un seul cycle planifié à la fois, sinon endormis
+    std::vector<ControleurCadence> cadences;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        cadences = controleurs;
+    }
+    std::vector<std::uint64_t> periodes(cadences.size());
+    std::vector<bool> planifies(cadences.size(), true);
+    for (size_t k = 0; k < cadences.size(); k++) {
+        double p = std::floor(cadences[k].periode / dt + 0.5);
+        periodes[k] = p >= 1.0 ? static_cast<std::uint64_t>(p) : 1;
+
+        ReveilPlanifie r;
+        r.tick = debutTick;
+        r.cible = static_cast<std::uint32_t>(k);
+        r.generation = 0;
+        r.type = TypeReveil::CONTROLEUR;
+        calendrier.planifier(r);
+    }
+
+    unsigned long long nbInstants = 0;
+    unsigned long long nbPasAvions = 0;         // Pas d'avion réellement intégrés
+    unsigned long long nbPasAvionsFixe = 0;     // Ce qu'aurait coûté le pas fixe
+    unsigned long long nbReveils = 0;
+
+    HorlogeMurale::time_point debut = HorlogeMurale::now();
+
+    std::uint64_t tick = debutTick;
+    while (tick < finTick) {
+        const double t = tick * dt;
+        horloge.positionner(t);
+        nbInstants++;
+
+        // 1. Réveils échus, dans l'ordre du calendrier
+        echus.clear();
+        aExecuter.clear();
+        calendrier.extraire(tick, echus);
+        {
+            std::lock_guard<std::mutex> lock(flotte.getMutex());
+            for (const ReveilPlanifie& r : echus) {
+                if (r.type == TypeReveil::CONTROLEUR) {
+                    aExecuter.push_back(r.cible);
+                }
+                else if (r.cible < flotte.taille() && flotte.endormi[r.cible] &&
+                    flotte.generationReveil[r.cible] == r.generation) {
+                    flotte.reveiller(r.cible, t);
+                    nbReveils++;
+                }
+            }
+        }
+
+        // 2. Décisions, sur un instantané publié à l'instant t
+        if (!aExecuter.empty()) {
+            std::sort(aExecuter.begin(), aExecuter.end());
+            {
+                std::lock_guard<std::mutex> lock(flotte.getMutex());
+                flotte.publier(t);
+            }
+            std::vector<ControleurCadence*> vagues;
+            for (size_t k : aExecuter) {
+                vagues.push_back(&cadences[k]);
+                planifies[k] = false;
+            }
+            executerVagues(vagues);
+        }
+
+        // Un contrôleur n'est recadencé que s'il a du travail ; un message
+        // ou un avion reçu entre-temps le réveille au pas suivant
+        for (size_t k = 0; k < cadences.size(); k++) {
+            if (planifies[k] || !cadences[k].controleur->aDuTravail()) continue;
+
+            bool vientDeTourner = std::find(aExecuter.begin(), aExecuter.end(), k) != aExecuter.end();
+            ReveilPlanifie r;
+            r.tick = tick + (vientDeTourner ? periodes[k] : 1);
+            r.cible = static_cast<std::uint32_t>(k);
+            r.generation = 0;
+            r.type = TypeReveil::CONTROLEUR;
+            calendrier.planifier(r);
+            planifies[k] = true;
+        }
+
+        // 3. Intégration des seuls avions éveillés
+        size_t eveilles = integrerEveilles(tick, dt, calendrier, nbPasAvions);
+        retirerVolsTermines();
+
+        // Les avions créés sont éveillés : pas de saut au prochain réveil
+        eveilles += creerAvionsDemandes();
+
+        // 4. Instant suivant : pas suivant si un avion est éveillé, sinon
+        // saut direct au prochain réveil
+        std::uint64_t suivant = finTick;
+        if (eveilles > 0) {
+            suivant = tick + 1;
+        }
+        else if (calendrier.prochain(suivant)) {
+            if (suivant <= tick) suivant = tick + 1;
+        }
+        suivant = suivant < finTick ? suivant : finTick;
+        nbPasAvionsFixe += (suivant - tick) * flotte.taille();
+        tick = suivant;
+    }
+
+    reporterStatistiques(cadences);
+
+    horloge.positionner(finTick * dt);
+    {
+        std::lock_guard<std::mutex> lock(flotte.getMutex());
+        flotte.publier(horloge.maintenant());
+    }
+    nbTicks += nbInstants;
+
+    std::chrono::duration<double> ecoule = HorlogeMurale::now() - debut;
+    std::cout << "[Ordonnanceur] " << nbInstants << " instants traites sur "
+        << (finTick - debutTick) << " pas, " << nbPasAvions << " pas d'avions integres sur "
+        << nbPasAvionsFixe << ", " << nbReveils << " reveils, en " << ecoule.count() << " s (x"
+        << (ecoule.count() > 0.0 ? dureeSimulee / ecoule.count() : 0.0) << " temps reel)\n";
+    afficherCadences();
+
+    std::ios::fmtflags format = std::cout.flags();
+    std::cout << "[Ordonnanceur] Empreinte de l'etat final : " << std::hex
+        << getEmpreinte() << "\n";
+    std::cout.flags(format);
+}
+
+size_t Ordonnanceur::integrerEveilles(std::uint64_t tick, double dt,
+    CalendrierEvenements& calendrier, unsigned long long& integres) {
+    std::lock_guard<std::mutex> lock(flotte.getMutex());
+
+    size_t eveilles = 0;
+    for (size_t i = 0; i < flotte.taille(); i++) {
+        if (flotte.endormi[i]) continue;
+
+        // Même enchaînement que tick() pour un avion : noyau puis validation
+        Avion* avion = flotte.getAvion(i);
+        avion->update(dt);
+        integres++;
+
+        if (avion->estTermine()) {
+            volsTermines.push_back(avion);
+            continue;
+        }
+
+        // Endormi seulement si le réveil est à plus d'un pas : un avion dont
+        // la phase se termine de toute façon reste intégré
+        double reveil;
+        if (avion->calculerReveil(reveil)) {
+            double pas = std::floor(reveil / dt);
+            if (pas > static_cast<double>(tick + 1)) {
+                ReveilPlanifie r;
+                r.tick = static_cast<std::uint64_t>(pas);
+                r.cible = static_cast<std::uint32_t>(i);
+                r.generation = flotte.endormir(i);
+                r.type = TypeReveil::AVION;
+                calendrier.planifier(r);
+                continue;
+            }
+        }
+        eveilles++;
+    }
+    return eveilles;
+}
+
+void Ordonnanceur::boucle() {
+    typedef std::chrono::steady_clock HorlogeMurale;
+
+    const HorlogeMurale::duration periode = std::chrono::duration_cast<HorlogeMurale::duration>(
+        std::chrono::duration<double>(1.0 / frequence));
+    const double dt = getPas();
+
+    std::cout << "[Ordonnanceur] " << getNbAvions() << " avions, "
+        << pool.getNbThreads() << " threads, " << frequence << " Hz"
+        << (Flotte::noyauxSIMD() ? " (AVX2)" : "") << "\n";
+
+    HorlogeMurale::time_point prochainTick = HorlogeMurale::now();
+
+    while (running.load()) {
+        tick(dt);
+
+        prochainTick += periode;
+        HorlogeMurale::time_point maintenant = HorlogeMurale::now();
+
+        if (maintenant > prochainTick) {
+            // Tick trop long : on ne rattrape pas le retard pour éviter l'emballement
+            nbTicksEnRetard++;
+            prochainTick = maintenant;
+        }
+        else {
+            std::this_thread::sleep_until(prochainTick);
+        }
+    }
+}
+
+unsigned long long Ordonnanceur::getEmpreinte() const {
+    std::lock_guard<std::mutex> lock(flotte.getMutex());
+    return flotte.empreinte();
+}
@@ -0,0 +1,141 @@
+#include "../include/PlanVol.h"
+#include <cmath>
+#include <utility>
+
+PlanVol::PlanVol() : longueur(0.0) {
+}
+
+PlanVol::PlanVol(const std::vector<Position>& points) : longueur(0.0) {
+    if (points.empty()) return;
+
+    for (size_t k = 1; k < points.size(); k++) {
+        double dx = points[k].x - points[k - 1].x;
+        double dy = points[k].y - points[k - 1].y;
+        double d = std::sqrt(dx * dx + dy * dy);
+        if (d <= 0.0) continue;
+
+        Troncon t;
+        t.x = points[k - 1].x;
+        t.y = points[k - 1].y;
+        t.ux = dx / d;
+        t.uy = dy / d;
+        t.longueur = d;
+        t.abscisse = longueur;
+        troncons.push_back(t);
+        longueur += d;
+    }
+
+    if (troncons.empty()) {
+        Troncon t;
+        t.x = points[0].x;
+        t.y = points[0].y;
+        t.ux = 1.0;
+        t.uy = 0.0;
+        t.longueur = 0.0;
+        t.abscisse = 0.0;
+        troncons.push_back(t);
+    }
+}
+
+void PlanVol::evaluer(double s, double& x, double& y, double& ux, double& uy) const {
+    if (troncons.empty()) return;
+
+    if (s < 0.0) s = 0.0;
+    if (s > longueur) s = longueur;
+
+    // Dernier tronçon commençant avant s (peu de tronçons : recherche dichotomique)
+    size_t bas = 0;
+    size_t haut = troncons.size();
+    while (haut - bas > 1) {
+        size_t milieu = (bas + haut) / 2;
+        if (troncons[milieu].abscisse <= s) bas = milieu;
+        else haut = milieu;
+    }
+
+    const Troncon& t = troncons[bas];
+    double le = s - t.abscisse;
+    if (le > t.longueur) le = t.longueur;
+    x = t.x + le * t.ux;
+    y = t.y + le * t.uy;
+    ux = t.ux;
+    uy = t.uy;
+}
+
+namespace {
+
+    // Côté d'une cellule de l'index des arrivées (mètres)
+    const double TAILLE_CELLE = 10000.0;
+
+    std::int32_t cellule(double coordonnee) {
+        return static_cast<std::int32_t>(std::floor(coordonnee / TAILLE_CELLE));
+    }
+
+    std::uint64_t cle(std::int32_t cx, std::int32_t cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+            static_cast<std::uint32_t>(cy);
+    }
+
+} // namespace
+
+ReseauRoutes::ReseauRoutes() : courante(nullptr) {
+    publier(std::unique_ptr<Table>(new Table()));
+}
+
+ReseauRoutes& ReseauRoutes::globale() {
+    static ReseauRoutes instance;
+    return instance;
+}
+
+void ReseauRoutes::publier(std::unique_ptr<Table> table) {
+    courante.store(table.get(), std::memory_order_release);
+    tables.push_back(std::move(table));
+}
+
+void ReseauRoutes::ajouter(const std::vector<Position>& points) {
+    if (points.size() < 2) return;
+
+    std::shared_ptr<RouteDeclaree> r = std::make_shared<RouteDeclaree>();
+    r->depart = points.front();
+    r->arrivee = points.back();
+    r->points = points;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_ptr<Table> table(new Table(*courante.load(std::memory_order_relaxed)));
+    table->parArrivee[cle(cellule(r->arrivee.x), cellule(r->arrivee.y))].push_back(table->routes.size());
+    table->routes.push_back(r);
+    publier(std::move(table));
+}
+
+std::shared_ptr<const RouteDeclaree> ReseauRoutes::trouver(const Position& depart,
+    const Position& arrivee, double tolerance) const {
+    const Table& table = *courante.load(std::memory_order_acquire);
+
+    // Cellules à moins de tolerance de l'arrivée ; la première route
+    // déclarée l'emporte, comme dans un parcours de toutes les routes
+    const std::int32_t rayon = static_cast<std::int32_t>(std::ceil(tolerance / TAILLE_CELLE));
+    const std::int32_t cx = cellule(arrivee.x);
+    const std::int32_t cy = cellule(arrivee.y);
+    size_t meilleure = table.routes.size();
+
+    for (std::int32_t dx = -rayon; dx <= rayon; dx++) {
+        for (std::int32_t dy = -rayon; dy <= rayon; dy++) {
+            auto it = table.parArrivee.find(cle(cx + dx, cy + dy));
+            if (it == table.parArrivee.end()) continue;
+
+            for (size_t k : it->second) {
+                if (k >= meilleure) break;
+                const RouteDeclaree& r = *table.routes[k];
+                if (r.depart.distanceTo(depart) < tolerance && r.arrivee.distanceTo(arrivee) < tolerance) {
+                    meilleure = k;
+                    break;
+                }
+            }
+        }
+    }
+    return meilleure < table.routes.size() ? table.routes[meilleure] : nullptr;
+}
+
+void ReseauRoutes::vider() {
+    std::lock_guard<std::mutex> lock(mtx);
+    publier(std::unique_ptr<Table>(new Table()));
+}
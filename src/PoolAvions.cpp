@@ -0,0 +1,146 @@
+#include "../include/PoolAvions.h"
+#include "../include/Avion.h"
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+struct PoolAvions::Emplacement {
+    typename std::aligned_storage<sizeof(Avion), alignof(Avion)>::type stockage;
+    std::atomic<std::uint32_t> generation;      // Impaire : emplacement occupé
+    std::uint32_t suivantLibre;
+
+    Avion* avion() { return reinterpret_cast<Avion*>(&stockage); }
+};
+
+PoolAvions::PoolAvions()
+    : nbEmplacements(0),
+    premierLibre(PoigneeAvion::AUCUN),
+    nbVivants(0),
+    nbCrees(0),
+    nbRecycles(0) {
+}
+
+PoolAvions::~PoolAvions() {
+    size_t n = nbEmplacements.load();
+    for (size_t i = 0; i < n; i++) {
+        Emplacement& e = emplacement(static_cast<std::uint32_t>(i));
+        if (e.generation.load() & 1u) {
+            e.avion()->~Avion();
+        }
+    }
+}
+
+PoolAvions& PoolAvions::globale() {
+    // La flotte et le registre, utilisés par le destructeur des avions,
+    // doivent survivre au pool
+    Flotte::globale();
+    RegistreAvions::globale();
+
+    static PoolAvions pool;
+    return pool;
+}
+
+PoolAvions::Emplacement& PoolAvions::emplacement(std::uint32_t i) const {
+    return pages[i / TAILLE_PAGE][i % TAILLE_PAGE];
+}
+
+std::uint32_t PoolAvions::reserver() {
+    if (premierLibre != PoigneeAvion::AUCUN) {
+        std::uint32_t i = premierLibre;
+        premierLibre = emplacement(i).suivantLibre;
+        nbRecycles++;
+        return i;
+    }
+
+    size_t n = nbEmplacements.load(std::memory_order_relaxed);
+    if (n >= TAILLE_PAGE * NB_PAGES_MAX) {
+        throw std::runtime_error("PoolAvions : capacite maximale atteinte");
+    }
+
+    // Nouvelle page à la demande ; les pages existantes ne bougent jamais
+    if (n % TAILLE_PAGE == 0) {
+        Emplacement* page = new Emplacement[TAILLE_PAGE];
+        for (size_t i = 0; i < TAILLE_PAGE; i++) {
+            page[i].generation.store(0, std::memory_order_relaxed);
+            page[i].suivantLibre = PoigneeAvion::AUCUN;
+        }
+        pages[n / TAILLE_PAGE].reset(page);
+    }
+
+    // Publication après l'initialisation de la page (lue sans verrou)
+    nbEmplacements.store(n + 1, std::memory_order_release);
+    return static_cast<std::uint32_t>(n);
+}
+
+PoigneeAvion PoolAvions::creer(const std::string& nom, const Position& depart,
+    const std::vector<Position>& destinations, Flotte& flotte) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    std::uint32_t i = reserver();
+    Emplacement& e = emplacement(i);
+
+    Avion* avion;
+    try {
+        avion = new (&e.stockage) Avion(nom, depart, destinations, flotte);
+    }
+    catch (...) {
+        e.suivantLibre = premierLibre;
+        premierLibre = i;
+        throw;
+    }
+
+    std::uint32_t generation = e.generation.load(std::memory_order_relaxed) + 1;
+    PoigneeAvion p(i, generation);
+    avion->poignee = p;
+    e.generation.store(generation, std::memory_order_release);
+
+    nbVivants++;
+    nbCrees++;
+    return p;
+}
+
+Avion* PoolAvions::obtenir(PoigneeAvion p) const {
+    if (p.emplacement >= nbEmplacements.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+
+    Emplacement& e = emplacement(p.emplacement);
+    if (e.generation.load(std::memory_order_acquire) != p.generation) {
+        return nullptr;
+    }
+    return e.avion();
+}
+
+bool PoolAvions::liberer(PoigneeAvion p) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (p.emplacement >= nbEmplacements.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    Emplacement& e = emplacement(p.emplacement);
+    if (e.generation.load(std::memory_order_relaxed) != p.generation) {
+        return false;
+    }
+
+    // Génération paire avant la destruction : les poignées en circulation
+    // sont périmées dès maintenant
+    e.generation.store(p.generation + 1, std::memory_order_release);
+    e.avion()->~Avion();
+
+    e.suivantLibre = premierLibre;
+    premierLibre = p.emplacement;
+    nbVivants--;
+    return true;
+}
+
+StatistiquesPool PoolAvions::getStatistiques() const {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    StatistiquesPool s;
+    s.vivants = nbVivants;
+    s.emplacements = nbEmplacements.load(std::memory_order_relaxed);
+    s.crees = nbCrees;
+    s.recycles = nbRecycles;
+    return s;
+}
@@ -0,0 +1,104 @@
+#include "../include/PoolThreads.h"
+#include <algorithm>
+
+PoolThreads::PoolThreads(size_t nbThreads)
+    : tache(nullptr),
+    nbElements(0),
+    tailleLot(1),
+    prochainLot(0),
+    generation(0),
+    workersTermines(0),
+    arret(false),
+    occupe(false) {
+
+    if (nbThreads == 0) {
+        nbThreads = std::thread::hardware_concurrency();
+        if (nbThreads == 0) nbThreads = 1;
+    }
+
+    // Le thread appelant compte comme un thread de calcul
+    for (size_t i = 1; i < nbThreads; i++) {
+        workers.emplace_back(&PoolThreads::boucleWorker, this, i);
+    }
+}
+
+PoolThreads::~PoolThreads() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        arret = true;
+    }
+    cvTravail.notify_all();
+
+    for (auto& t : workers) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void PoolThreads::paralleliser(size_t n, size_t lot, const TacheLot& f) {
+    if (n == 0) return;
+    if (lot == 0) lot = 1;
+
+    // Pas la peine de réveiller les workers pour un seul lot ; pool déjà
+    // occupé : les workers ne sont pas disponibles
+    bool libre = false;
+    if (workers.empty() || n <= lot || !occupe.compare_exchange_strong(libre, true)) {
+        f(0, n, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        tache = &f;
+        nbElements = n;
+        tailleLot = lot;
+        prochainLot.store(0);
+        workersTermines = 0;
+        generation++;
+    }
+    cvTravail.notify_all();
+
+    executerLots(0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    cvFin.wait(lock, [this]() { return workersTermines == workers.size(); });
+    tache = nullptr;
+    occupe.store(false);
+}
+
+void PoolThreads::executerLots(size_t indice) {
+    const size_t nbLots = (nbElements + tailleLot - 1) / tailleLot;
+
+    while (true) {
+        size_t lot = prochainLot.fetch_add(1);
+        if (lot >= nbLots) break;
+
+        size_t debut = lot * tailleLot;
+        size_t fin = std::min(debut + tailleLot, nbElements);
+        (*tache)(debut, fin, indice);
+    }
+}
+
+void PoolThreads::boucleWorker(size_t indice) {
+    unsigned long derniereGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cvTravail.wait(lock, [this, derniereGeneration]() {
+                return arret || generation != derniereGeneration;
+            });
+            if (arret) return;
+            derniereGeneration = generation;
+        }
+
+        executerLots(indice);
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            workersTermines++;
+        }
+        cvFin.notify_one();
+    }
+}
@@ -0,0 +1,126 @@
+#include "../include/RegistreAvions.h"
+#include <stdexcept>
+
+RegistreAvions::RegistreAvions() : suspensionsRecyclage(0), nbIds(0), nbControleurs(0) {
+    for (size_t i = 0; i < NB_CONTROLEURS_MAX; i++) {
+        controleurs[i].store(nullptr);
+        nomsControleurs[i].store(TableTextes::AUCUN);
+    }
+}
+
+RegistreAvions& RegistreAvions::globale() {
+    static RegistreAvions registre;
+    return registre;
+}
+
+IdAvion RegistreAvions::attribuerId(const std::string& nom) {
+    auto it = ids.find(nom);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    IdAvion id;
+    if (suspensionsRecyclage == 0 && libres.size() > QUARANTAINE) {
+        // Le plus ancien identifiant libéré ; son propriétaire est remis à zéro
+        id = libres.front();
+        libres.pop_front();
+        noms[id] = nom;
+        proprietaireRef(id).store(AUCUN_CONTROLEUR, std::memory_order_release);
+    }
+    else {
+        size_t n = nbIds.load(std::memory_order_relaxed);
+        if (n >= TAILLE_PAGE * NB_PAGES_MAX) {
+            throw std::runtime_error("RegistreAvions : capacite maximale atteinte");
+        }
+
+        // Nouvelle page à la demande ; les pages existantes ne bougent jamais
+        if (n % TAILLE_PAGE == 0) {
+            std::atomic<int>* page = new std::atomic<int>[TAILLE_PAGE];
+            for (size_t i = 0; i < TAILLE_PAGE; i++) {
+                page[i].store(AUCUN_CONTROLEUR, std::memory_order_relaxed);
+            }
+            pages[n / TAILLE_PAGE].reset(page);
+        }
+
+        id = static_cast<IdAvion>(n);
+        noms.push_back(nom);
+        references.push_back(0);
+        nbIds.store(n + 1, std::memory_order_release);
+    }
+
+    ids[nom] = id;
+    return id;
+}
+
+IdAvion RegistreAvions::interner(const std::string& nom) {
+    std::lock_guard<std::mutex> lock(mtx);
+    IdAvion id = attribuerId(nom);
+    references[id] = PERMANENT;
+    return id;
+}
+
+IdAvion RegistreAvions::acquerir(const std::string& nom) {
+    std::lock_guard<std::mutex> lock(mtx);
+    IdAvion id = attribuerId(nom);
+    if (references[id] != PERMANENT) references[id]++;
+    return id;
+}
+
+void RegistreAvions::relacher(IdAvion id) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (id >= references.size() || references[id] == PERMANENT || references[id] == 0) return;
+
+    // Sans trace ouverte, le nom est oublié et l'identifiant mis en quarantaine ;
+    // sinon il reste attaché à son nom, comme un nom interné
+    if (--references[id] > 0 || suspensionsRecyclage > 0) return;
+    ids.erase(noms[id]);
+    libres.push_back(id);
+}
+
+void RegistreAvions::suspendreRecyclage() {
+    std::lock_guard<std::mutex> lock(mtx);
+    suspensionsRecyclage++;
+}
+
+void RegistreAvions::reprendreRecyclage() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (suspensionsRecyclage > 0) suspensionsRecyclage--;
+}
+
+IdAvion RegistreAvions::trouver(const std::string& nom) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = ids.find(nom);
+    return it != ids.end() ? it->second : ID_INVALIDE;
+}
+
+std::string RegistreAvions::getNom(IdAvion id) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return noms.at(id);
+}
+
+int RegistreAvions::enregistrerControleur(ControleurBase* controleur, const std::string& nom) {
+    int id = nbControleurs.fetch_add(1);
+    if (id >= static_cast<int>(NB_CONTROLEURS_MAX)) {
+        throw std::runtime_error("RegistreAvions : trop de controleurs");
+    }
+    nomsControleurs[id].store(TableTextes::globale().interner(nom), std::memory_order_release);
+    controleurs[id].store(controleur, std::memory_order_release);
+    return id;
+}
+
+void RegistreAvions::desenregistrerControleur(int idControleur) {
+    if (idControleur < 0 || idControleur >= static_cast<int>(NB_CONTROLEURS_MAX)) return;
+    controleurs[idControleur].store(nullptr, std::memory_order_release);
+}
+
+ControleurBase* RegistreAvions::getControleur(int idControleur) const {
+    if (idControleur < 0 || idControleur >= static_cast<int>(NB_CONTROLEURS_MAX)) return nullptr;
+    return controleurs[idControleur].load(std::memory_order_acquire);
+}
+
+const std::string& RegistreAvions::getNomControleur(int idControleur) const {
+    if (idControleur < 0 || idControleur >= static_cast<int>(NB_CONTROLEURS_MAX)) {
+        return TableTextes::globale().get(TableTextes::AUCUN);
+    }
+    return TableTextes::globale().get(nomsControleurs[idControleur].load(std::memory_order_acquire));
+}
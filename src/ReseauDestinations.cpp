@@ -0,0 +1,163 @@
+#include "../include/ReseauDestinations.h"
+#include <mutex>
+
+constexpr double ReseauDestinations::DISTANCE_MIN;
+constexpr double ReseauDestinations::TOLERANCE_ORIGINE;
+
+TableDestinations::TableDestinations(const std::vector<Position>& aeroports,
+    const std::vector<double>& poids, size_t origine, double distanceMin)
+    : uniforme(true),
+    tirage(true) {
+    const Position& depart = aeroports[origine];
+
+    double somme = 0.0;
+    for (size_t i = 0; i < aeroports.size(); i++) {
+        if (depart.distanceTo(aeroports[i]) > distanceMin) {
+            candidats.push_back(static_cast<std::uint32_t>(i));
+            if (!poids.empty()) somme += poids[i];
+        }
+    }
+
+    if (candidats.empty()) {
+        // Repli : la destination la plus éloignée, sans tirage
+        double maxDistance = 0.0;
+        size_t plusLoin = origine;
+        for (size_t i = 0; i < aeroports.size(); i++) {
+            double distance = depart.distanceTo(aeroports[i]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                plusLoin = i;
+            }
+        }
+        candidats.push_back(static_cast<std::uint32_t>(plusLoin));
+        tirage = false;
+        return;
+    }
+
+    if (poids.empty() || somme <= 0.0) return;
+
+    // Méthode des alias de Vose : chaque case reçoit au plus deux candidats
+    const size_t n = candidats.size();
+    std::vector<double> p(n);
+    std::vector<std::uint32_t> petits;
+    std::vector<std::uint32_t> grands;
+    for (size_t k = 0; k < n; k++) {
+        p[k] = poids[candidats[k]] * n / somme;
+        (p[k] < 1.0 ? petits : grands).push_back(static_cast<std::uint32_t>(k));
+    }
+
+    seuils.assign(n, 1.0);
+    alias.resize(n);
+    for (size_t k = 0; k < n; k++) alias[k] = static_cast<std::uint32_t>(k);
+
+    while (!petits.empty() && !grands.empty()) {
+        std::uint32_t s = petits.back();
+        petits.pop_back();
+        std::uint32_t l = grands.back();
+
+        seuils[s] = p[s];
+        alias[s] = l;
+        p[l] = (p[l] + p[s]) - 1.0;
+        if (p[l] < 1.0) {
+            grands.pop_back();
+            petits.push_back(l);
+        }
+    }
+
+    // Les cases restantes (erreurs d'arrondi) gardent un seuil de 1
+    for (size_t k = 0; k < n; k++) {
+        if (seuils[k] < 1.0) {
+            uniforme = false;
+            break;
+        }
+    }
+}
+
+ReseauDestinations::ReseauDestinations(const std::vector<Position>& aeroports,
+    const std::vector<double>& poids)
+    : aeroports(aeroports),
+    poids(poids.size() == aeroports.size() ? poids : std::vector<double>()) {
+    tables.reserve(aeroports.size());
+    for (size_t i = 0; i < aeroports.size(); i++) {
+        tables.push_back(TableDestinations(this->aeroports, this->poids, i, DISTANCE_MIN));
+    }
+}
+
+std::shared_ptr<const ReseauDestinations> ReseauDestinations::partager(
+    const std::vector<Position>& aeroports, const std::vector<double>& poids) {
+    static std::mutex mtx;
+    static std::vector<std::shared_ptr<const ReseauDestinations>> partages;
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    for (const auto& r : partages) {
+        if (r->aeroports.size() != aeroports.size()) continue;
+        if (r->poids != (poids.size() == aeroports.size() ? poids : std::vector<double>())) continue;
+
+        bool identique = true;
+        for (size_t i = 0; i < aeroports.size() && identique; i++) {
+            identique = r->aeroports[i].x == aeroports[i].x &&
+                r->aeroports[i].y == aeroports[i].y &&
+                r->aeroports[i].altitude == aeroports[i].altitude;
+        }
+        if (identique) return r;
+    }
+
+    std::shared_ptr<const ReseauDestinations> r = std::make_shared<ReseauDestinations>(aeroports, poids);
+    partages.push_back(r);
+    return r;
+}
+
+int ReseauDestinations::trouverOrigine(const Position& pos) const {
+    int origine = HORS_RESEAU;
+    double meilleure = TOLERANCE_ORIGINE;
+    for (size_t i = 0; i < aeroports.size(); i++) {
+        double distance = aeroports[i].distanceTo(pos);
+        if (distance <= meilleure) {
+            meilleure = distance;
+            origine = static_cast<int>(i);
+        }
+    }
+    return origine;
+}
+
+size_t ReseauDestinations::tirerDepuis(const Position& pos, FluxAleatoire& flux) const {
+    // Première passe : candidats et poids total
+    size_t nb = 0;
+    double somme = 0.0;
+    double maxDistance = 0.0;
+    size_t plusLoin = 0;
+    for (size_t i = 0; i < aeroports.size(); i++) {
+        double distance = pos.distanceTo(aeroports[i]);
+        if (distance > DISTANCE_MIN) {
+            nb++;
+            if (!poids.empty()) somme += poids[i];
+        }
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            plusLoin = i;
+        }
+    }
+
+    if (nb == 0) return plusLoin;
+
+    // Seconde passe : k-ième candidat (uniforme) ou poids cumulé (pondéré)
+    if (poids.empty() || somme <= 0.0) {
+        size_t k = static_cast<size_t>(flux.entier(0, static_cast<int>(nb) - 1));
+        for (size_t i = 0; i < aeroports.size(); i++) {
+            if (pos.distanceTo(aeroports[i]) > DISTANCE_MIN && k-- == 0) return i;
+        }
+    }
+    else {
+        double cible = flux.reel() * somme;
+        size_t dernier = plusLoin;
+        for (size_t i = 0; i < aeroports.size(); i++) {
+            if (pos.distanceTo(aeroports[i]) <= DISTANCE_MIN) continue;
+            dernier = i;
+            cible -= poids[i];
+            if (cible < 0.0) return i;
+        }
+        return dernier;
+    }
+    return plusLoin;
+}
@@ -0,0 +1,124 @@
+#include "../include/SequenceAtterrissage.h"
+#include <utility>
+
+SequenceAtterrissage::SequenceAtterrissage() : prochainOrdre(0) {
+}
+
+bool SequenceAtterrissage::avant(const CreneauAtterrissage& a, const CreneauAtterrissage& b) const {
+    if (a.priorite != b.priorite) return a.priorite > b.priorite;
+    if (a.heureEstimee != b.heureEstimee) return a.heureEstimee < b.heureEstimee;
+    return a.ordre < b.ordre;
+}
+
+void SequenceAtterrissage::echanger(size_t i, size_t j) {
+    std::swap(tas[i], tas[j]);
+    index[tas[i].avion] = i;
+    index[tas[j].avion] = j;
+}
+
+void SequenceAtterrissage::monter(size_t i) {
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!avant(tas[i], tas[parent])) break;
+        echanger(i, parent);
+        i = parent;
+    }
+}
+
+void SequenceAtterrissage::descendre(size_t i) {
+    const size_t n = tas.size();
+    while (true) {
+        size_t gauche = 2 * i + 1;
+        if (gauche >= n) break;
+
+        size_t meilleur = gauche;
+        if (gauche + 1 < n && avant(tas[gauche + 1], tas[gauche])) {
+            meilleur = gauche + 1;
+        }
+        if (!avant(tas[meilleur], tas[i])) break;
+        echanger(i, meilleur);
+        i = meilleur;
+    }
+}
+
+void SequenceAtterrissage::replacer(size_t i) {
+    if (i > 0 && avant(tas[i], tas[(i - 1) / 2])) {
+        monter(i);
+    }
+    else {
+        descendre(i);
+    }
+}
+
+bool SequenceAtterrissage::inserer(IdAvion avion, double heureEstimee, PrioriteAtterrissage priorite) {
+    if (!index.insert(std::make_pair(avion, tas.size())).second) {
+        return false;
+    }
+
+    CreneauAtterrissage c;
+    c.avion = avion;
+    c.heureEstimee = heureEstimee;
+    c.priorite = priorite;
+    c.ordre = prochainOrdre++;
+    tas.push_back(c);
+    monter(tas.size() - 1);
+    return true;
+}
+
+bool SequenceAtterrissage::reordonner(IdAvion avion, double heureEstimee) {
+    auto it = index.find(avion);
+    if (it == index.end()) return false;
+
+    size_t i = it->second;
+    if (tas[i].heureEstimee == heureEstimee) return true;
+    tas[i].heureEstimee = heureEstimee;
+    replacer(i);
+    return true;
+}
+
+bool SequenceAtterrissage::prioriser(IdAvion avion, PrioriteAtterrissage priorite) {
+    auto it = index.find(avion);
+    if (it == index.end()) return false;
+
+    size_t i = it->second;
+    if (tas[i].priorite == priorite) return true;
+    tas[i].priorite = priorite;
+    replacer(i);
+    return true;
+}
+
+bool SequenceAtterrissage::retirer(IdAvion avion) {
+    auto it = index.find(avion);
+    if (it == index.end()) return false;
+
+    size_t i = it->second;
+    index.erase(it);
+
+    // La dernière case comble le trou, puis reprend sa place
+    size_t dernier = tas.size() - 1;
+    if (i != dernier) {
+        tas[i] = tas[dernier];
+        index[tas[i].avion] = i;
+    }
+    tas.pop_back();
+    if (i < tas.size()) {
+        replacer(i);
+    }
+    return true;
+}
+
+const CreneauAtterrissage* SequenceAtterrissage::trouver(IdAvion avion) const {
+    auto it = index.find(avion);
+    return it == index.end() ? nullptr : &tas[it->second];
+}
+
+IdAvion SequenceAtterrissage::extrairePremier() {
+    IdAvion avion = tas.front().avion;
+    retirer(avion);
+    return avion;
+}
+
+void SequenceAtterrissage::vider() {
+    tas.clear();
+    index.clear();
+}
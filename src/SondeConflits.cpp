@@ -0,0 +1,229 @@
+#include "../include/SondeConflits.h"
+#include "../include/Avion.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+    const double HAUTEUR_TRANCHE = 1000.0;   // Tranches d'altitude des seaux (m)
+
+    std::int64_t cleSeau(int seau, int cx, int cy, int cz) {
+        return (static_cast<std::int64_t>(seau & 0xFFFF) << 48) |
+            (static_cast<std::int64_t>(cx & 0xFFFFF) << 28) |
+            (static_cast<std::int64_t>(cy & 0xFFFFF) << 8) |
+            static_cast<std::int64_t>(cz & 0xFF);
+    }
+
+    int cellule(double v, double taille) {
+        return static_cast<int>(std::floor(v / taille));
+    }
+
+} // namespace
+
+SondeConflits::SondeConflits(double horizon, double separationH,
+    double separationV, double tailleCellule)
+    : horizon(horizon),
+    separationH(separationH),
+    separationV(separationV),
+    tailleCellule(tailleCellule > 0.0 ? tailleCellule : 20000.0) {
+}
+
+Trajectoire SondeConflits::extrapoler(Avion* avion) {
+    Trajectoire t;
+    t.avion = avion;
+    t.depart = avion->getPosition();
+    t.vx = avion->getVitesseX();
+    t.vy = avion->getVitesseY();
+    t.vz = avion->getVitesseVerticale();
+
+    switch (avion->getEtat()) {
+    case EtatAvion::PARKING:
+    case EtatAvion::ROULAGE_DECOLLAGE:
+    case EtatAvion::ROULAGE_ARRIVEE:
+        // Au sol : pas de trajectoire à surveiller
+        t.duree = 0.0;
+        break;
+
+    case EtatAvion::MONTEE:
+    case EtatAvion::CROISIERE:
+    case EtatAvion::DESCENTE:
+    case EtatAvion::APPROCHE: {
+        // Cap direct vers la destination : la trajectoire s'arrête à l'arrivée
+        double v = std::sqrt(t.vx * t.vx + t.vy * t.vy);
+        double d = t.depart.distanceTo(avion->getDestination());
+        t.duree = v > 0.0 ? d / v : std::numeric_limits<double>::max();
+        break;
+    }
+
+    default:
+        t.duree = std::numeric_limits<double>::max();
+        break;
+    }
+
+    return t;
+}
+
+std::vector<std::pair<size_t, size_t>> SondeConflits::pairesCandidates(
+    const std::vector<Trajectoire>& trajectoires) const {
+
+    // Durée d'une tranche : un avion rapide parcourt environ une cellule par tranche
+    double vMax = 0.0;
+    for (const auto& t : trajectoires) {
+        vMax = std::max(vMax, std::sqrt(t.vx * t.vx + t.vy * t.vy));
+    }
+    double dureeSeau = vMax > 0.0 ? tailleCellule / vMax : horizon;
+    dureeSeau = std::min(std::max(dureeSeau, 1.0), std::max(horizon, 1.0));
+
+    const double marge = separationH / 2.0;
+    const double margeV = separationV / 2.0;
+
+    // (tranche de temps + cellule, trajectoire) ; trié ensuite pour regrouper les seaux
+    std::vector<std::pair<std::int64_t, std::uint32_t>> seaux;
+
+    for (size_t i = 0; i < trajectoires.size(); i++) {
+        const Trajectoire& t = trajectoires[i];
+        double duree = std::min(horizon, t.duree);
+        if (duree <= 0.0) continue;
+
+        for (int k = 0; k * dureeSeau <= duree; k++) {
+            double t0 = k * dureeSeau;
+            double t1 = std::min(t0 + dureeSeau, duree);
+
+            double x0 = t.depart.x + t.vx * t0;
+            double x1 = t.depart.x + t.vx * t1;
+            double y0 = t.depart.y + t.vy * t0;
+            double y1 = t.depart.y + t.vy * t1;
+            double z0 = t.depart.altitude + t.vz * t0;
+            double z1 = t.depart.altitude + t.vz * t1;
+
+            // Boîte balayée pendant la tranche, élargie de la demi-séparation
+            int cxMin = cellule(std::min(x0, x1) - marge, tailleCellule);
+            int cxMax = cellule(std::max(x0, x1) + marge, tailleCellule);
+            int cyMin = cellule(std::min(y0, y1) - marge, tailleCellule);
+            int cyMax = cellule(std::max(y0, y1) + marge, tailleCellule);
+            int czMin = cellule(std::min(z0, z1) - margeV, HAUTEUR_TRANCHE);
+            int czMax = cellule(std::max(z0, z1) + margeV, HAUTEUR_TRANCHE);
+
+            for (int cx = cxMin; cx <= cxMax; cx++) {
+                for (int cy = cyMin; cy <= cyMax; cy++) {
+                    for (int cz = czMin; cz <= czMax; cz++) {
+                        seaux.push_back(std::make_pair(cleSeau(k, cx, cy, cz), static_cast<std::uint32_t>(i)));
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(seaux.begin(), seaux.end());
+
+    // Toutes les paires partageant un seau, puis dédoublonnage
+    std::vector<std::uint64_t> cles;
+    for (size_t debut = 0; debut < seaux.size();) {
+        size_t fin = debut + 1;
+        while (fin < seaux.size() && seaux[fin].first == seaux[debut].first) fin++;
+
+        // Dans un seau, les indices sont triés par ordre croissant
+        for (size_t a = debut; a < fin; a++) {
+            for (size_t b = a + 1; b < fin; b++) {
+                if (seaux[a].second == seaux[b].second) continue;
+                cles.push_back((static_cast<std::uint64_t>(seaux[a].second) << 32) | seaux[b].second);
+            }
+        }
+        debut = fin;
+    }
+
+    std::sort(cles.begin(), cles.end());
+    cles.erase(std::unique(cles.begin(), cles.end()), cles.end());
+
+    std::vector<std::pair<size_t, size_t>> paires;
+    paires.reserve(cles.size());
+    for (std::uint64_t c : cles) {
+        paires.push_back(std::make_pair(static_cast<size_t>(c >> 32), static_cast<size_t>(c & 0xFFFFFFFFu)));
+    }
+    return paires;
+}
+
+bool SondeConflits::evaluer(const Trajectoire& a, const Trajectoire& b,
+    ConflitPrevu& conflit) const {
+
+    double fin = std::min(horizon, std::min(a.duree, b.duree));
+    if (fin <= 0.0) return false;
+
+    // Mouvement relatif de b par rapport à a
+    double px = b.depart.x - a.depart.x;
+    double py = b.depart.y - a.depart.y;
+    double pz = b.depart.altitude - a.depart.altitude;
+    double vx = b.vx - a.vx;
+    double vy = b.vy - a.vy;
+    double vz = b.vz - a.vz;
+
+    // Intervalle où la séparation horizontale est perdue : |p + v t| < separationH
+    double qa = vx * vx + vy * vy;
+    double qb = px * vx + py * vy;
+    double qc = px * px + py * py - separationH * separationH;
+
+    double debutH, finH;
+    if (qa == 0.0) {
+        if (qc >= 0.0) return false;
+        debutH = 0.0;
+        finH = fin;
+    }
+    else {
+        double discriminant = qb * qb - qa * qc;
+        if (discriminant <= 0.0) return false;
+        double racine = std::sqrt(discriminant);
+        debutH = (-qb - racine) / qa;
+        finH = (-qb + racine) / qa;
+    }
+
+    // Intervalle où la séparation verticale est perdue : |pz + vz t| < separationV
+    double debutV, finV;
+    if (vz == 0.0) {
+        if (std::abs(pz) >= separationV) return false;
+        debutV = 0.0;
+        finV = fin;
+    }
+    else {
+        double t1 = (-separationV - pz) / vz;
+        double t2 = (separationV - pz) / vz;
+        debutV = std::min(t1, t2);
+        finV = std::max(t1, t2);
+    }
+
+    double debut = std::max(0.0, std::max(debutH, debutV));
+    double finConflit = std::min(fin, std::min(finH, finV));
+    if (debut >= finConflit) return false;
+
+    // Point de rapprochement maximal (horizontal) sur l'horizon
+    double tCPA = qa > 0.0 ? -qb / qa : 0.0;
+    tCPA = std::min(std::max(tCPA, 0.0), fin);
+    double dx = px + vx * tCPA;
+    double dy = py + vy * tCPA;
+
+    conflit.avion1 = a.avion;
+    conflit.avion2 = b.avion;
+    conflit.tempsAvantConflit = debut;
+    conflit.tempsPointRapproche = tCPA;
+    conflit.distanceMinimale = std::sqrt(dx * dx + dy * dy);
+    return true;
+}
+
+std::vector<ConflitPrevu> SondeConflits::sonder(const std::vector<Trajectoire>& trajectoires) const {
+    std::vector<ConflitPrevu> conflits;
+
+    for (const auto& p : pairesCandidates(trajectoires)) {
+        ConflitPrevu c;
+        if (evaluer(trajectoires[p.first], trajectoires[p.second], c)) {
+            conflits.push_back(c);
+        }
+    }
+
+    std::stable_sort(conflits.begin(), conflits.end(),
+        [](const ConflitPrevu& a, const ConflitPrevu& b) {
+            return a.tempsAvantConflit < b.tempsAvantConflit;
+        });
+
+    return conflits;
+}
@@ -2,9 +2,17 @@
 #include <iostream>
 #include <iomanip>
 
+namespace {
+
+    std::string nomAvion(IdAvion id) {
+        return id == RegistreAvions::ID_INVALIDE ? "" : RegistreAvions::globale().getNom(id);
+    }
+
+} // namespace
+
 TWR::TWR(const std::string& nom) : ControleurBase(nom) {
     piste.occupee = false;
-    piste.avionActuel = "";
+    piste.avionActuel = RegistreAvions::ID_INVALIDE;
     initialiserParkings(1);
 }
 
@@ -12,30 +20,64 @@ void TWR::initialiserParkings(int nombre) {
     std::lock_guard<std::mutex> lock(mtx);
 
     for (int i = 1; i <= nombre; i++) {
-        Parking p;
-        p.id = "P" + std::to_string(i);
-        p.occupee = false;
-        p.avionActuel = "";
-        p.distancePiste = 100.0 * i;
-        p.position = Position(50.0 * i, 100.0, 0);
-
-        parkings[p.id] = p;
+        parkings.ajouter("P" + std::to_string(i), 100.0 * i, Position(50.0 * i, 100.0, 0));
     }
 
-    logAction("INIT_PARKINGS", "Initialisation de " + std::to_string(nombre) + " parkings");
+    EvenementTrace e(TypeEvenement::INIT_PARKINGS);
+    e.valeur1 = nombre;
+    logEvenement(e);
 }
 
-bool TWR::pisteLibre() const {
+void TWR::abonner(ControleurBase* abonne) {
+    if (abonne == nullptr) return;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto* a : abonnes) {
+        if (a == abonne) return;
+    }
+    abonnes.push_back(abonne);
+}
+
+void TWR::desabonner(ControleurBase* abonne) {
     std::lock_guard<std::mutex> lock(mtx);
-    return pisteLibreInternal();
+    for (size_t i = 0; i < abonnes.size(); i++) {
+        if (abonnes[i] == abonne) {
+            abonnes.erase(abonnes.begin() + i);
+            return;
+        }
+    }
+}
+
+void TWR::publierPiste() {
+    std::uint64_t sequence = etatPiste.publier(piste.occupee, piste.avionActuel, piste.heureLiberation);
+    if (abonnes.empty()) return;
+
+    Message msg;
+    msg.type = piste.occupee ? TypeEvenement::PISTE_OCCUPEE : TypeEvenement::PISTE_LIBEREE;
+    msg.expediteur = static_cast<std::int16_t>(idControleur);
+    msg.avion = piste.avionActuel;
+    msg.charge.evenement.avion1 = piste.avionActuel;
+    msg.charge.evenement.valeur1 = piste.heureLiberation;
+    msg.charge.evenement.valeur2 = static_cast<double>(sequence);
+    msg.timestamp = static_cast<std::int64_t>(horloge->maintenant() * 1000.0);
+
+    // Une boîte pleine ne perd que la notification : l'abonné relit de
+    // toute façon l'état publié à son prochain cycle
+    for (auto* abonne : abonnes) {
+        msg.destinataire = static_cast<std::int16_t>(abonne->getIdControleur());
+        abonne->envoyerMessage(msg);
+    }
+}
+
+bool TWR::pisteLibre() const {
+    // Lecture sans verrou de l'état publié
+    InstantanePiste etat = etatPiste.lire();
+    return !etat.occupee || horloge->maintenant() >= etat.heureLiberation;
 }
 
 bool TWR::pisteLibreInternal() const {
     if (piste.occupee) {
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-            now - piste.heureLiberation).count();
-        return elapsed >= 0;
+        return horloge->maintenant() >= piste.heureLiberation;
     }
     return true;
 }
@@ -48,58 +90,61 @@ bool TWR::autoriserAtterrissage(const std::string& avionId) {
     }
 
     piste.occupee = true;
-    piste.avionActuel = avionId;
-    piste.heureLiberation = std::chrono::steady_clock::now() +
-        std::chrono::seconds(piste.DUREE_ATTERRISSAGE);
-
-    logAction("AUTORISATION_ATTERRISSAGE", "Avion " + avionId + " autorisé à atterrir");
+    // Un avion vivant garde son identifiant recyclable ; un nom inconnu est interné
+    RegistreAvions& registre = RegistreAvions::globale();
+    piste.avionActuel = registre.trouver(avionId);
+    if (piste.avionActuel == RegistreAvions::ID_INVALIDE) piste.avionActuel = registre.interner(avionId);
+    piste.heureLiberation = horloge->maintenant() + piste.DUREE_ATTERRISSAGE;
+    publierPiste();
+
+    EvenementTrace e(TypeEvenement::AUTORISATION_ATTERRISSAGE);
+    e.avion1 = piste.avionActuel;
+    logEvenement(e);
     return true;
 }
 
 std::string TWR::getParkingDisponible() const {
     std::lock_guard<std::mutex> lock(mtx);
 
-    for (const auto& pair : parkings) {
-        if (!pair.second.occupee) {
-            return pair.first;
-        }
-    }
-
-    return "";
+    int numero = parkings.premierLibre();
+    return numero == AllocateurParkings::AUCUN ? "" : parkings.get(numero).id;
 }
 
 void TWR::libererParking(const std::string& parkingId) {
     std::lock_guard<std::mutex> lock(mtx);
 
-    auto it = parkings.find(parkingId);
-    if (it != parkings.end()) {
-        it->second.occupee = false;
-        it->second.avionActuel = "";
-        logAction("LIBERATION_PARKING", "Parking " + parkingId + " libéré");
+    int numero = parkings.trouver(parkingId);
+    if (numero != AllocateurParkings::AUCUN) {
+        parkings.liberer(numero);
+        EvenementTrace e(TypeEvenement::LIBERATION_PARKING);
+        e.texte1 = &parkingId;
+        logEvenement(e);
     }
 }
-void TWR::processLogic() {
+void TWR::avionDisparu(const Avion*, IdAvion id) {
     std::lock_guard<std::mutex> lock(mtx);
 
-    
-    if (!avionsSousControle.empty()) {
-        
-        piste.occupee = true;
-
-        
-        if (avionsSousControle.front() != nullptr) {
-            piste.avionActuel = avionsSousControle.front()->getNom();
-        }
-    }
-    else {
-        // Piste libre
+    // Un avion rendu au pool ne doit bloquer ni la piste ni son parking
+    if (piste.avionActuel == id) {
         piste.occupee = false;
-        piste.avionActuel = "";
+        piste.avionActuel = RegistreAvions::ID_INVALIDE;
+        publierPiste();
+    }
+    int numero = parkings.libererAvion(id);
+    if (numero != AllocateurParkings::AUCUN) {
+        EvenementTrace e(TypeEvenement::LIBERATION_PARKING);
+        e.texte1 = &parkings.get(numero).id;
+        logEvenement(e);
     }
+}
+
+void TWR::processLogic() {
+    std::lock_guard<std::mutex> lock(mtx);
 
-    // Log existant
+    // L'état de piste ne change que sur autorisation, libération ou
+    // disparition d'avion, et chaque changement est publié aussitôt
     if (piste.occupee) {
-        std::cout << "[TWR " << nom << "] Piste occupee [" << piste.avionActuel
+        std::cout << "[TWR " << nom << "] Piste occupee [" << nomAvion(piste.avionActuel)
             << "] | " << avionsSousControle.size() << " avions sous controle\n";
     }
 
@@ -113,27 +158,28 @@ void TWR::gererAtterrissages() {
     
 
     if (piste.occupee) {
-        auto now = std::chrono::steady_clock::now();
-        if (now >= piste.heureLiberation) {
-            std::string parkingId = assignerParking();
+        if (horloge->maintenant() >= piste.heureLiberation) {
+            int numero = parkings.premierLibre();
 
-            if (!parkingId.empty()) {
+            if (numero != AllocateurParkings::AUCUN) {
                 for (auto* avion : avionsSousControle) {
-                    if (avion->getNom() == piste.avionActuel) {
+                    if (avion->getId() == piste.avionActuel) {
                         avion->setEtat(EtatAvion::ROULAGE_ARRIVEE);
 
-                        parkings[parkingId].occupee = true;
-                        parkings[parkingId].avionActuel = piste.avionActuel;
+                        parkings.occuper(numero, piste.avionActuel);
 
-                        logAction("ROULAGE_VERS_PARKING",
-                            "Avion " + piste.avionActuel + " roule vers " + parkingId);
+                        EvenementTrace e(TypeEvenement::ROULAGE_VERS_PARKING);
+                        e.avion1 = avion->getId();
+                        e.texte1 = &parkings.get(numero).id;
+                        logEvenement(e);
                         break;
                     }
                 }
             }
 
             piste.occupee = false;
-            piste.avionActuel = "";
+            piste.avionActuel = RegistreAvions::ID_INVALIDE;
+            publierPiste();
         }
     }
 }
@@ -144,7 +190,9 @@ void TWR::gererRoulage() {
     for (auto* avion : avionsSousControle) {
         if (avion->getEtat() == EtatAvion::ROULAGE_ARRIVEE) {
             avion->setEtat(EtatAvion::PARKING);
-            logAction("AVION_STATIONNE", "Avion " + avion->getNom() + " stationné");
+            EvenementTrace e(TypeEvenement::AVION_STATIONNE);
+            e.avion1 = avion->getId();
+            logEvenement(e);
         }
     }
 }
@@ -157,58 +205,46 @@ void TWR::gererDecollages() {
         double distanceMax = 0;
 
         for (auto* avion : avionsSousControle) {
-            if (avion->getEtat() == EtatAvion::PARKING) {
-                for (const auto& pair : parkings) {
-                    if (pair.second.occupee && pair.second.avionActuel == avion->getNom()) {
-                        if (pair.second.distancePiste > distanceMax) {
-                            distanceMax = pair.second.distancePiste;
-                            avionPrioritaire = avion;
-                        }
-                        break;
-                    }
+            if (etatAJour(avion) && etatPublie(avion).getEtat() == EtatAvion::PARKING) {
+                // Index inverse : le parking de l'avion sans parcourir les parkings
+                int numero = parkings.parkingDe(avion->getId());
+                if (numero != AllocateurParkings::AUCUN &&
+                    parkings.get(numero).distancePiste > distanceMax) {
+                    distanceMax = parkings.get(numero).distancePiste;
+                    avionPrioritaire = avion;
                 }
             }
         }
 
         if (avionPrioritaire != nullptr) {
-            avionPrioritaire->setEtat(EtatAvion::ROULAGE_DECOLLAGE);
-
-            
-            for (auto& pair : parkings) {
-                if (pair.second.occupee && pair.second.avionActuel == avionPrioritaire->getNom()) {
-                    pair.second.occupee = false;
-                    pair.second.avionActuel = "";
-                    logAction("LIBERATION_PARKING", "Parking " + pair.first + " libéré");
-                    break;
-                }
-            }
+            appliquerEtat(avionPrioritaire, EtatAvion::ROULAGE_DECOLLAGE);
 
-            logAction("AUTORISATION_DECOLLAGE",
-                "Avion " + avionPrioritaire->getNom() + " autorisé à rouler vers la piste");
-        }
-    }
-}
+            int numero = parkings.libererAvion(avionPrioritaire->getId());
+            if (numero != AllocateurParkings::AUCUN) {
+                EvenementTrace e(TypeEvenement::LIBERATION_PARKING);
+                e.texte1 = &parkings.get(numero).id;
+                logEvenement(e);
+            }
 
-std::string TWR::assignerParking() {
-    for (auto& pair : parkings) {
-        if (!pair.second.occupee) {
-            return pair.first;
+            EvenementTrace e(TypeEvenement::AUTORISATION_DECOLLAGE);
+            e.avion1 = avionPrioritaire->getId();
+            logEvenement(e);
         }
     }
-    return "";
 }
 
 void TWR::afficherPlanAeroport() const {
     std::lock_guard<std::mutex> lock(mtx);
 
     std::cout << "\n=== TOUR DE CONTROLE - " << nom << " ===\n";
-    std::cout << "PISTE: " << (piste.occupee ? "OCCUPEE [" + piste.avionActuel + "]" : "LIBRE") << "\n";
+    std::cout << "PISTE: " << (piste.occupee ? "OCCUPEE [" + nomAvion(piste.avionActuel) + "]" : "LIBRE") << "\n";
     std::cout << "\nPARKINGS:\n";
 
-    for (const auto& pair : parkings) {
-        std::cout << "  " << pair.first << ": ";
-        if (pair.second.occupee) {
-            std::cout << pair.second.avionActuel;
+    for (size_t i = 0; i < parkings.taille(); i++) {
+        const Parking& p = parkings.get(static_cast<int>(i));
+        std::cout << "  " << p.id << ": ";
+        if (p.occupee) {
+            std::cout << nomAvion(p.avionActuel);
         }
         else {
             std::cout << "DISPONIBLE";
@@ -0,0 +1,33 @@
+#include "../include/TableTextes.h"
+
+TableTextes& TableTextes::globale() {
+    static TableTextes table;
+    return table;
+}
+
+IdTexte TableTextes::interner(const std::string& texte) {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = ids.find(texte);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    IdTexte id = static_cast<IdTexte>(textes.size());
+    ids[texte] = id;
+    textes.push_back(texte);
+    return id;
+}
+
+const std::string& TableTextes::get(IdTexte id) const {
+    static const std::string vide;
+    if (id == AUCUN) return vide;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    return id < textes.size() ? textes[id] : vide;
+}
+
+size_t TableTextes::taille() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return textes.size();
+}
@@ -0,0 +1,443 @@
+#include "../include/TraceBinaire.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+    const std::uint32_t AUCUN_TEXTE = 0xFFFFFFFFu;
+
+    std::atomic<unsigned long> prochainIdentifiant(1);
+
+    template <typename T>
+    void ecrireBrut(std::ostream& sortie, const T* donnees, size_t n) {
+        sortie.write(reinterpret_cast<const char*>(donnees), static_cast<std::streamsize>(n * sizeof(T)));
+    }
+
+    template <typename T>
+    void ecrireValeur(std::ostream& sortie, T valeur) {
+        ecrireBrut(sortie, &valeur, 1);
+    }
+
+    // Colonne complétée par des zéros jusqu'à la capacité du bloc
+    template <typename T>
+    void ecrireColonne(std::ostream& sortie, const std::vector<T>& colonne, std::uint32_t capacite) {
+        ecrireBrut(sortie, colonne.data(), colonne.size());
+        std::vector<T> zeros(capacite - colonne.size(), T());
+        ecrireBrut(sortie, zeros.data(), zeros.size());
+    }
+
+    void ecrireChaine(std::ostream& sortie, const std::string& s) {
+        ecrireValeur(sortie, static_cast<std::uint32_t>(s.size()));
+        sortie.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+    template <typename T>
+    bool lireBrut(std::istream& entree, T* donnees, size_t n) {
+        entree.read(reinterpret_cast<char*>(donnees), static_cast<std::streamsize>(n * sizeof(T)));
+        return static_cast<bool>(entree);
+    }
+
+    template <typename T>
+    bool lireValeur(std::istream& entree, T& valeur) {
+        return lireBrut(entree, &valeur, 1);
+    }
+
+    bool lireChaines(std::istream& entree, std::vector<std::string>& chaines) {
+        std::uint32_t n = 0;
+        if (!lireValeur(entree, n)) return false;
+        chaines.resize(n);
+        for (auto& s : chaines) {
+            std::uint32_t longueur = 0;
+            if (!lireValeur(entree, longueur)) return false;
+            s.resize(longueur);
+            if (longueur > 0 && !entree.read(&s[0], longueur)) return false;
+        }
+        return true;
+    }
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Écriture
+// ---------------------------------------------------------------------------
+
+// Événements d'un contrôleur pas encore versés dans le bloc commun
+struct TraceBinaire::Tampon {
+    std::mutex mtx;                     // Libre en pratique : un contrôleur journalise depuis son cycle
+    std::uint16_t controleur;
+    std::string nomControleur;
+    std::vector<EnregistrementTrace> enregistrements;   // Textes en identifiants locaux
+
+    // Textes internés localement, puis une fois pour toutes dans la trace
+    std::unordered_map<std::string, std::uint32_t> idsTextes;
+    std::vector<const std::string*> textes;             // Clés de idsTextes
+    std::vector<std::uint32_t> versTrace;               // Local -> identifiant de la trace
+
+    std::uint32_t internerTexte(const std::string* texte) {
+        if (texte == nullptr) return AUCUN_TEXTE;
+
+        auto it = idsTextes.find(*texte);
+        if (it != idsTextes.end()) return it->second;
+
+        std::uint32_t id = static_cast<std::uint32_t>(textes.size());
+        it = idsTextes.insert(std::make_pair(*texte, id)).first;
+        textes.push_back(&it->first);
+        return id;
+    }
+};
+
+TraceBinaire::TraceBinaire(const std::string& chemin, std::uint32_t capaciteBloc)
+    : capaciteBloc(capaciteBloc > 0 ? capaciteBloc : 4096),
+    identifiant(prochainIdentifiant.fetch_add(1)),
+    ouverte(false),
+    idAvionMax(0),
+    nbEnregistrements(0) {
+
+    fichier.open(chemin, std::ios::binary | std::ios::trunc);
+    if (!fichier.is_open()) return;
+
+    // Le dictionnaire des avions est écrit à la fermeture : aucun identifiant
+    // ne doit changer de nom d'ici là
+    RegistreAvions::globale().suspendreRecyclage();
+
+    fichier.write(FormatTrace::MAGIQUE, sizeof(FormatTrace::MAGIQUE));
+    ecrireValeur(fichier, FormatTrace::VERSION);
+    ecrireValeur(fichier, this->capaciteBloc);
+
+    colType.reserve(this->capaciteBloc);
+    colControleur.reserve(this->capaciteBloc);
+    colAvion1.reserve(this->capaciteBloc);
+    colAvion2.reserve(this->capaciteBloc);
+    colTexte1.reserve(this->capaciteBloc);
+    colTexte2.reserve(this->capaciteBloc);
+    colHorodatage.reserve(this->capaciteBloc);
+    colValeur1.reserve(this->capaciteBloc);
+    colValeur2.reserve(this->capaciteBloc);
+    ouverte.store(true, std::memory_order_release);
+}
+
+TraceBinaire::~TraceBinaire() {
+    fermer();
+}
+
+std::uint32_t TraceBinaire::internerTexte(const std::string* texte) {
+    if (texte == nullptr) return AUCUN_TEXTE;
+
+    auto it = idsTextes.find(*texte);
+    if (it != idsTextes.end()) return it->second;
+
+    std::uint32_t id = static_cast<std::uint32_t>(textes.size());
+    idsTextes[*texte] = id;
+    textes.push_back(*texte);
+    return id;
+}
+
+TraceBinaire::Tampon& TraceBinaire::tamponDe(size_t controleur, const std::string& nomControleur) {
+    // Tampons déjà vus par ce thread, retrouvés sans verrou
+    thread_local unsigned long traceCache = 0;
+    thread_local std::vector<Tampon*> cache;
+
+    if (traceCache != identifiant) {
+        cache.clear();
+        traceCache = identifiant;
+    }
+    if (controleur < cache.size() && cache[controleur] != nullptr) {
+        return *cache[controleur];
+    }
+
+    std::lock_guard<std::mutex> lock(mtxTampons);
+    if (controleur >= tampons.size()) tampons.resize(controleur + 1);
+    if (!tampons[controleur]) {
+        tampons[controleur].reset(new Tampon());
+        tampons[controleur]->controleur = static_cast<std::uint16_t>(controleur);
+        tampons[controleur]->nomControleur = nomControleur;
+        tampons[controleur]->enregistrements.reserve(TAILLE_LOT);
+    }
+    if (controleur >= cache.size()) cache.resize(controleur + 1, nullptr);
+    cache[controleur] = tampons[controleur].get();
+    return *cache[controleur];
+}
+
+void TraceBinaire::ajouter(const EvenementTrace& e, int idControleur,
+    const std::string& nomControleur, std::int64_t horodatage) {
+
+    if (!ouverte.load(std::memory_order_acquire)) return;
+
+    size_t c = idControleur >= 0 ? static_cast<size_t>(idControleur) : 0;
+    Tampon& tampon = tamponDe(c, nomControleur);
+    std::lock_guard<std::mutex> lock(tampon.mtx);
+
+    EnregistrementTrace r;
+    r.type = e.type;
+    r.controleur = tampon.controleur;
+    r.avion1 = e.avion1;
+    r.avion2 = e.avion2;
+    r.texte1 = tampon.internerTexte(e.texte1);
+    r.texte2 = tampon.internerTexte(e.texte2);
+    r.horodatage = horodatage;
+    r.valeur1 = e.valeur1;
+    r.valeur2 = e.valeur2;
+    tampon.enregistrements.push_back(r);
+
+    if (tampon.enregistrements.size() >= TAILLE_LOT) {
+        verser(tampon);
+    }
+}
+
+void TraceBinaire::verser(Tampon& tampon) {
+    if (tampon.enregistrements.empty()) return;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!fichier.is_open()) {
+        tampon.enregistrements.clear();
+        return;
+    }
+
+    size_t c = tampon.controleur;
+    if (c >= nomsControleurs.size()) nomsControleurs.resize(c + 1);
+    if (nomsControleurs[c].empty()) nomsControleurs[c] = tampon.nomControleur;
+
+    // Textes apparus depuis le dernier lot
+    for (size_t i = tampon.versTrace.size(); i < tampon.textes.size(); i++) {
+        tampon.versTrace.push_back(internerTexte(tampon.textes[i]));
+    }
+
+    for (const auto& r : tampon.enregistrements) {
+        colType.push_back(static_cast<std::uint16_t>(r.type));
+        colControleur.push_back(r.controleur);
+        colAvion1.push_back(r.avion1);
+        colAvion2.push_back(r.avion2);
+        colTexte1.push_back(r.texte1 == AUCUN_TEXTE ? AUCUN_TEXTE : tampon.versTrace[r.texte1]);
+        colTexte2.push_back(r.texte2 == AUCUN_TEXTE ? AUCUN_TEXTE : tampon.versTrace[r.texte2]);
+        colHorodatage.push_back(r.horodatage);
+        colValeur1.push_back(r.valeur1);
+        colValeur2.push_back(r.valeur2);
+
+        if (r.avion1 != RegistreAvions::ID_INVALIDE) idAvionMax = std::max(idAvionMax, r.avion1 + 1);
+        if (r.avion2 != RegistreAvions::ID_INVALIDE) idAvionMax = std::max(idAvionMax, r.avion2 + 1);
+        nbEnregistrements++;
+
+        if (colType.size() == capaciteBloc) {
+            ecrireBloc();
+        }
+    }
+    tampon.enregistrements.clear();
+}
+
+void TraceBinaire::ecrireBloc() {
+    if (colType.empty()) return;
+
+    EntreeIndex entree;
+    entree.position = static_cast<std::uint64_t>(fichier.tellp());
+    entree.nombre = static_cast<std::uint32_t>(colType.size());
+    entree.horodatageMin = *std::min_element(colHorodatage.begin(), colHorodatage.end());
+    entree.horodatageMax = *std::max_element(colHorodatage.begin(), colHorodatage.end());
+    index.push_back(entree);
+
+    ecrireValeur(fichier, FormatTrace::MAGIQUE_BLOC);
+    ecrireValeur(fichier, entree.nombre);
+    ecrireValeur(fichier, entree.horodatageMin);
+    ecrireValeur(fichier, entree.horodatageMax);
+
+    ecrireColonne(fichier, colType, capaciteBloc);
+    ecrireColonne(fichier, colControleur, capaciteBloc);
+    ecrireColonne(fichier, colAvion1, capaciteBloc);
+    ecrireColonne(fichier, colAvion2, capaciteBloc);
+    ecrireColonne(fichier, colTexte1, capaciteBloc);
+    ecrireColonne(fichier, colTexte2, capaciteBloc);
+    ecrireColonne(fichier, colHorodatage, capaciteBloc);
+    ecrireColonne(fichier, colValeur1, capaciteBloc);
+    ecrireColonne(fichier, colValeur2, capaciteBloc);
+    fichier.flush();
+
+    colType.clear();
+    colControleur.clear();
+    colAvion1.clear();
+    colAvion2.clear();
+    colTexte1.clear();
+    colTexte2.clear();
+    colHorodatage.clear();
+    colValeur1.clear();
+    colValeur2.clear();
+}
+
+void TraceBinaire::fermer() {
+    ouverte.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lockTampons(mtxTampons);
+        for (auto& tampon : tampons) {
+            if (!tampon) continue;
+            std::lock_guard<std::mutex> lockTampon(tampon->mtx);
+            verser(*tampon);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!fichier.is_open()) return;
+
+    ecrireBloc();
+
+    // Dictionnaires
+    std::uint64_t positionDictionnaires = static_cast<std::uint64_t>(fichier.tellp());
+
+    ecrireValeur(fichier, static_cast<std::uint32_t>(nomsControleurs.size()));
+    for (const auto& s : nomsControleurs) ecrireChaine(fichier, s);
+
+    RegistreAvions& registre = RegistreAvions::globale();
+    IdAvion nbAvions = std::min<IdAvion>(idAvionMax, static_cast<IdAvion>(registre.taille()));
+    ecrireValeur(fichier, static_cast<std::uint32_t>(nbAvions));
+    for (IdAvion id = 0; id < nbAvions; id++) ecrireChaine(fichier, registre.getNom(id));
+
+    ecrireValeur(fichier, static_cast<std::uint32_t>(textes.size()));
+    for (const auto& s : textes) ecrireChaine(fichier, s);
+
+    // Index des blocs
+    std::uint64_t positionIndex = static_cast<std::uint64_t>(fichier.tellp());
+    ecrireValeur(fichier, static_cast<std::uint32_t>(index.size()));
+    for (const auto& e : index) {
+        ecrireValeur(fichier, e.position);
+        ecrireValeur(fichier, e.nombre);
+        ecrireValeur(fichier, e.horodatageMin);
+        ecrireValeur(fichier, e.horodatageMax);
+    }
+
+    // Pied de fichier
+    ecrireValeur(fichier, positionDictionnaires);
+    ecrireValeur(fichier, positionIndex);
+    fichier.write(FormatTrace::MAGIQUE_FIN, sizeof(FormatTrace::MAGIQUE_FIN));
+    fichier.close();
+    registre.reprendreRecyclage();
+}
+
+unsigned long long TraceBinaire::getNbEnregistrements() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return nbEnregistrements;
+}
+
+// ---------------------------------------------------------------------------
+// Lecture
+// ---------------------------------------------------------------------------
+
+LecteurTrace::LecteurTrace() : capaciteBloc(0), complete(false) {
+}
+
+bool LecteurTrace::ouvrir(const std::string& chemin) {
+    fichier.open(chemin, std::ios::binary);
+    if (!fichier.is_open()) return false;
+
+    char magique[8];
+    std::uint32_t version = 0;
+    if (!fichier.read(magique, sizeof(magique)) ||
+        !std::equal(magique, magique + 8, FormatTrace::MAGIQUE) ||
+        !lireValeur(fichier, version) || version != FormatTrace::VERSION ||
+        !lireValeur(fichier, capaciteBloc) || capaciteBloc == 0) {
+        return false;
+    }
+
+    fichier.seekg(0, std::ios::end);
+    std::uint64_t taille = static_cast<std::uint64_t>(fichier.tellg());
+
+    // Pied de fichier : dictionnaires et index
+    if (taille >= FormatTrace::TAILLE_EN_TETE + 24) {
+        std::uint64_t positionDictionnaires = 0, positionIndex = 0;
+        char fin[8];
+        fichier.seekg(static_cast<std::streamoff>(taille - 24));
+        if (lireValeur(fichier, positionDictionnaires) && lireValeur(fichier, positionIndex) &&
+            fichier.read(fin, sizeof(fin)) && std::equal(fin, fin + 8, FormatTrace::MAGIQUE_FIN)) {
+
+            fichier.seekg(static_cast<std::streamoff>(positionDictionnaires));
+            bool ok = lireChaines(fichier, nomsControleurs) &&
+                lireChaines(fichier, nomsAvions) &&
+                lireChaines(fichier, textes);
+
+            std::uint32_t nbBlocs = 0;
+            fichier.seekg(static_cast<std::streamoff>(positionIndex));
+            ok = ok && lireValeur(fichier, nbBlocs);
+            index.resize(ok ? nbBlocs : 0);
+            for (auto& e : index) {
+                ok = ok && lireValeur(fichier, e.position) && lireValeur(fichier, e.nombre) &&
+                    lireValeur(fichier, e.horodatageMin) && lireValeur(fichier, e.horodatageMax);
+            }
+
+            if (ok) {
+                complete = true;
+                return true;
+            }
+        }
+    }
+
+    // Trace interrompue : les blocs de taille fixe se parcourent sans index
+    fichier.clear();
+    index.clear();
+    nomsControleurs.clear();
+    nomsAvions.clear();
+    textes.clear();
+
+    const std::uint64_t tailleBloc = FormatTrace::tailleBloc(capaciteBloc);
+    for (std::uint64_t position = FormatTrace::TAILLE_EN_TETE; position + tailleBloc <= taille;
+        position += tailleBloc) {
+
+        std::uint32_t magiqueBloc = 0;
+        TraceBinaire::EntreeIndex e;
+        e.position = position;
+        fichier.seekg(static_cast<std::streamoff>(position));
+        if (!lireValeur(fichier, magiqueBloc) || magiqueBloc != FormatTrace::MAGIQUE_BLOC ||
+            !lireValeur(fichier, e.nombre) || !lireValeur(fichier, e.horodatageMin) ||
+            !lireValeur(fichier, e.horodatageMax) || e.nombre > capaciteBloc) {
+            break;
+        }
+        index.push_back(e);
+    }
+    return true;
+}
+
+bool LecteurTrace::lireBloc(size_t bloc, std::vector<EnregistrementTrace>& enregistrements) {
+    if (bloc >= index.size()) return false;
+
+    const TraceBinaire::EntreeIndex& e = index[bloc];
+    const size_t n = e.nombre;
+    enregistrements.assign(n, EnregistrementTrace());
+
+    std::vector<std::uint16_t> col16(capaciteBloc);
+    std::vector<std::uint32_t> col32(capaciteBloc);
+    std::vector<std::int64_t> col64(capaciteBloc);
+    std::vector<double> colDouble(capaciteBloc);
+
+    fichier.clear();
+    fichier.seekg(static_cast<std::streamoff>(e.position + FormatTrace::TAILLE_EN_TETE_BLOC));
+
+    if (!lireBrut(fichier, col16.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].type = static_cast<TypeEvenement>(col16[i]);
+    if (!lireBrut(fichier, col16.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].controleur = col16[i];
+    if (!lireBrut(fichier, col32.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].avion1 = col32[i];
+    if (!lireBrut(fichier, col32.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].avion2 = col32[i];
+    if (!lireBrut(fichier, col32.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].texte1 = col32[i];
+    if (!lireBrut(fichier, col32.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].texte2 = col32[i];
+    if (!lireBrut(fichier, col64.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].horodatage = col64[i];
+    if (!lireBrut(fichier, colDouble.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].valeur1 = colDouble[i];
+    if (!lireBrut(fichier, colDouble.data(), capaciteBloc)) return false;
+    for (size_t i = 0; i < n; i++) enregistrements[i].valeur2 = colDouble[i];
+
+    return true;
+}
+
+std::string LecteurTrace::nomControleur(std::uint16_t id) const {
+    return id < nomsControleurs.size() ? nomsControleurs[id] : "#" + std::to_string(id);
+}
+
+std::string LecteurTrace::nomAvion(IdAvion id) const {
+    if (id == RegistreAvions::ID_INVALIDE) return "";
+    return id < nomsAvions.size() ? nomsAvions[id] : "#" + std::to_string(id);
+}
+
+std::string LecteurTrace::texte(std::uint32_t id) const {
+    if (id == AUCUN_TEXTE) return "";
+    return id < textes.size() ? textes[id] : "#" + std::to_string(id);
+}
@@ -0,0 +1,71 @@
+#include "../include/TraceBinaire.h"
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Convertit une trace binaire en fichiers log_<contrôleur>.json,
+// identiques à ceux écrits directement par les contrôleurs.
+// Usage : TraceVersJSON trace.bin [repertoire]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage : " << argv[0] << " trace [repertoire]\n";
+        return 1;
+    }
+
+    std::string repertoire = argc > 2 ? std::string(argv[2]) : std::string(".");
+    if (!repertoire.empty() && repertoire.back() != '/') repertoire += '/';
+
+    LecteurTrace lecteur;
+    if (!lecteur.ouvrir(argv[1])) {
+        std::cerr << "Trace illisible : " << argv[1] << "\n";
+        return 1;
+    }
+    if (!lecteur.estComplete()) {
+        std::cerr << "Trace incomplete : noms des avions et textes indisponibles\n";
+    }
+
+    std::map<std::uint16_t, std::unique_ptr<std::ofstream>> fichiers;
+    std::vector<EnregistrementTrace> enregistrements;
+    std::string ligne;
+    unsigned long long total = 0;
+
+    for (size_t b = 0; b < lecteur.getNbBlocs(); b++) {
+        if (!lecteur.lireBloc(b, enregistrements)) {
+            std::cerr << "Bloc " << b << " illisible\n";
+            break;
+        }
+
+        for (const auto& e : enregistrements) {
+            std::unique_ptr<std::ofstream>& fichier = fichiers[e.controleur];
+            if (!fichier) {
+                fichier.reset(new std::ofstream(repertoire + "log_" + lecteur.nomControleur(e.controleur) + ".json"));
+                *fichier << "[\n";
+            }
+
+            ligne.clear();
+            ligne.append("{\"expediteur\":\"").append(lecteur.nomControleur(e.controleur));
+            ligne.append("\",\"destinataire\":\"LOG");
+            ligne.append("\",\"type\":\"").append(nomTypeEvenement(e.type));
+            ligne.append("\",\"avionId\":\"");
+            ligne.append("\",\"contenu\":\"");
+            ajouterContenu(ligne, e.type,
+                lecteur.nomAvion(e.avion1), lecteur.nomAvion(e.avion2),
+                lecteur.texte(e.texte1), lecteur.texte(e.texte2),
+                e.valeur1, e.valeur2);
+            ligne.append("\",\"timestamp\":").append(std::to_string(static_cast<long>(e.horodatage)));
+            ligne.append("},\n");
+            *fichier << ligne;
+            total++;
+        }
+    }
+
+    for (auto& f : fichiers) {
+        *f.second << "]\n";
+    }
+
+    std::cout << total << " evenements, " << fichiers.size() << " fichiers\n";
+    return 0;
+}
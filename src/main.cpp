@@ -2,10 +2,17 @@
 #include "../include/CCR.h"
 #include "../include/APP.h"
 #include "../include/TWR.h"
+#include "../include/Ordonnanceur.h"
+#include "../include/TraceBinaire.h"
 #include <iostream>
 #include <vector>
 #include <thread>
 #include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <random>
 #include <SFML/Graphics.hpp>
 
 using namespace sf;
@@ -21,10 +28,10 @@ const int WINDOW_SIZE_Y = 1104;
 #define M_PI 3.14159265358979323846
 #endif
 
-float calculerAngleRotation(const Position& posAvion, const Position& destination) {
-    double dx = destination.x - posAvion.x;
-    double dy = destination.y - posAvion.y;
-    double angleRadians = std::atan2(dy, dx);
+// Cap publié dans l'instantané : jamais lu dans les colonnes de la flotte,
+// que l'ordonnanceur modifie pendant l'affichage
+float calculerAngleRotation(const EtatPublie& etat) {
+    double angleRadians = std::atan2(etat.dirY, etat.dirX);
     double angleDegres = angleRadians * 180.0 / M_PI;
     return static_cast<float>(angleDegres);
 }
@@ -60,14 +67,20 @@ Vector2f worldToScreenDynamic(const Position& posAvion,
     return Vector2f(screen_x, screen_y);
 }
 
-void initializeSimulation() {
-    RenderWindow window(VideoMode({ WINDOW_SIZE_X, WINDOW_SIZE_Y }), "Air Traffic Control - Rotation d'attente");
-    window.setFramerateLimit(60);
-
+// sansAffichage : simulation en temps virtuel, sans fenêtre, pendant dureeSimulee secondes
+// nbThreads : threads de calcul de l'ordonnanceur (0 : un par coeur)
+// evenementiel : sans affichage, seuls les avions et contrôleurs actifs avancent
+void initializeSimulation(bool sansAffichage = false, double dureeSimulee = 0.0, size_t nbThreads = 0,
+    bool evenementiel = false) {
     std::vector<Avion*> planes;
     std::vector<APP*> airports;
     std::vector<TWR*> towers;
-    std::vector<std::thread> planeThreads;
+
+    // Tous les avions avancent par lots sur un pool de threads (60 Hz, temps x3)
+    Ordonnanceur ordonnanceur(nbThreads, 60.0, 3.0);
+
+    // Les avions reçoivent l'horloge virtuelle de l'ordonnanceur tant qu'il
+    // existe ; les contrôleurs la partagent (setHorloge plus bas)
 
     Vector2f screenLille(600, 80);
     Vector2f screenNantes(280, 450);
@@ -136,79 +149,82 @@ void initializeSimulation() {
 
     std::vector<Position> toutesDestinations = { posLille, posNantes, posToulouse, posLyon };
 
-    // CRÉER PLUSIEURS AVIONS 
-    Avion* p1 = new Avion("AF123", posLille, toutesDestinations);
+    // CRÉER PLUSIEURS AVIONS (dans le pool : l'ordonnanceur les y rendra)
+    PoolAvions& pool = PoolAvions::globale();
+    Avion* p1 = pool.obtenir(pool.creer("AF123", posLille, toutesDestinations));
     planes.push_back(p1);
     ccr->ajouterAvion(p1);
 
-    Avion* p2 = new Avion("LH456", posToulouse, toutesDestinations);
+    Avion* p2 = pool.obtenir(pool.creer("LH456", posToulouse, toutesDestinations));
     planes.push_back(p2);
     ccr->ajouterAvion(p2);
 
-    Avion* p3 = new Avion("BA789", posNantes, toutesDestinations);
+    Avion* p3 = pool.obtenir(pool.creer("BA789", posNantes, toutesDestinations));
     planes.push_back(p3);
     ccr->ajouterAvion(p3);
 
 
-    Avion* p4 = new Avion("EZ321", posLyon, toutesDestinations);
+    Avion* p4 = pool.obtenir(pool.creer("EZ321", posLyon, toutesDestinations));
     planes.push_back(p4);
     ccr->ajouterAvion(p4);
 
-    Avion* p5 = new Avion("RY654", posNantes, toutesDestinations);
+    Avion* p5 = pool.obtenir(pool.creer("RY654", posNantes, toutesDestinations));
     planes.push_back(p5);
     ccr->ajouterAvion(p5);
 
-    Avion::demarrerSimulation();
+    ccr->setHorloge(ordonnanceur.getHorloge());
+    ccr->activerDetectionParallele(&ordonnanceur.getPool());
+    for (auto* airport : airports) {
+        airport->setHorloge(ordonnanceur.getHorloge());
+    }
+    for (auto* tower : towers) {
+        tower->setHorloge(ordonnanceur.getHorloge());
+    }
 
+    // Les contrôleurs sont cadencés par l'ordonnanceur (phase de décision de
+    // chaque pas), pas par leurs threads : l'exécution est déterministe.
+    // Vagues : le CCR, puis les TWR en parallèle, puis les APP en parallèle
+    // (un APP appelle sa TWR, jamais un autre APP). Les TWR passent avant
+    // les APP : un changement de piste est vu par l'APP au même pas
     for (auto* plane : planes) {
-        if (plane != nullptr) {
-            planeThreads.emplace_back([plane]() {
-                try {
-                    plane->demarrer();
-                }
-                catch (const std::exception& e) {
-                    std::cerr << "Erreur avion " << plane->getNom() << ": " << e.what() << "\n";
-                }
-                });
-            std::cout << "  Avion " << plane->getNom() << " demarre\n";
-        }
+        ordonnanceur.ajouterAvion(plane);
     }
-
-    try {
-        ccr->demarrer();
-        std::cout << " CCR demarre\n";
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ordonnanceur.ajouterControleur(ccr, 0.3, 0);
+    for (auto* tower : towers) {
+        ordonnanceur.ajouterControleur(tower, 0.3, 1);
     }
-    catch (const std::exception& e) {
-        std::cerr << " ERREUR CCR: " << e.what() << "\n";
-        return;
+    for (auto* airport : airports) {
+        ordonnanceur.ajouterControleur(airport, 0.3, 2);
     }
 
-    for (size_t i = 0; i < airports.size(); i++) {
-        try {
-            airports[i]->demarrer();
-            std::cout << " APP " << (i + 1) << " demarre\n";
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (sansAffichage) {
+        if (evenementiel) {
+            ordonnanceur.executerEvenements(dureeSimulee);
         }
-        catch (const std::exception& e) {
-            std::cerr << " ERREUR APP " << (i + 1) << ": " << e.what() << "\n";
+        else {
+            ordonnanceur.executerSansAffichage(dureeSimulee);
         }
-    }
 
-    for (size_t i = 0; i < towers.size(); i++) {
-        try {
-            towers[i]->demarrer();
-            std::cout << " TWR " << (i + 1) << " demarre\n";
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        for (auto* airport : airports) {
+            delete airport;
         }
-        catch (const std::exception& e) {
-            std::cerr << " ERREUR TWR " << (i + 1) << ": " << e.what() << "\n";
+        for (auto* tower : towers) {
+            delete tower;
         }
+        delete ccr;
+
+        std::cout << "\n=== SIMULATION TERMINÉE ===\n";
+        return;
     }
 
+    ordonnanceur.demarrer();
+
     std::cout << "\n=== SIMULATION DEMARREE ===\n";
     std::cout << "Avions: " << planes.size() << " | Aéroports: 4" << airports.size() << "\n\n";
 
+    RenderWindow window(VideoMode({ WINDOW_SIZE_X, WINDOW_SIZE_Y }), "Air Traffic Control - Rotation d'attente");
+    window.setFramerateLimit(60);
+
     // Chargement des textures
     Texture backgroundImage;
     if (!backgroundImage.loadFromFile(std::string(PATH_IMG) + "france.png")) {
@@ -289,33 +305,21 @@ void initializeSimulation() {
                 event->getIf<sf::Event::KeyPressed>()->code == sf::Keyboard::Key::Escape) ||
                 event->is<sf::Event::Closed>()) {
 
-                for (auto* plane : planes) {
-                    plane->arreter();
-                }
-                for (auto& thread : planeThreads) {
-                    if (thread.joinable()) {
-                        thread.join();
-                    }
-                }
-
-                ccr->arreter();
-                for (auto* airport : airports) {
-                    airport->arreter();
-                }
-                for (auto* tower : towers) {
-                    tower->arreter();
-                }
-
+                ordonnanceur.arreter();
                 window.close();
             }
         }
 
         float deltaTime = clock.restart().asSeconds();
 
+        // Un seul instantané par image : tous les avions au même pas de simulation
+        LectureFlotte instantane = Flotte::globale().lire();
+
         for (size_t i = 0; i < planes.size() && i < planeSprites.size(); i++) {
             if (planes[i] != nullptr) {
                 try {
-                    EtatAvion etat = planes[i]->getEtat();
+                    EtatPublie publie = instantane.etat(planes[i]);
+                    EtatAvion etat = publie.getEtat();
 
                     // ✅ SI EN PARKING, NE PAS DESSINER
                     if (etat == EtatAvion::PARKING) {
@@ -323,13 +327,12 @@ void initializeSimulation() {
                         continue;  // Passer au prochain avion
                     }
 
-                    Position posAvion = planes[i]->getPosition();
-                    Position destination = planes[i]->getDestination();
+                    Position posAvion = publie.getPosition();
 
                     Vector2f screenPos = worldToScreenDynamic(posAvion, screenAirports, worldAirports);
                     planeSprites[i].setPosition(screenPos);
 
-                    float angleDegres = calculerAngleRotation(posAvion, destination);
+                    float angleDegres = calculerAngleRotation(publie);
                     planeSprites[i].setRotation(sf::degrees(angleDegres));
 
                     if (etat == EtatAvion::CROISIERE) {
@@ -374,19 +377,9 @@ void initializeSimulation() {
         window.display();
     }
 
-    for (auto* plane : planes) {
-        plane->arreter();
-    }
-
-    for (auto& thread : planeThreads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
-    }
+    ordonnanceur.arreter();
 
-    for (auto* plane : planes) {
-        delete plane;
-    }
+    // Les avions appartiennent à l'ordonnanceur
     for (auto* airport : airports) {
         delete airport;
     }
@@ -398,7 +391,78 @@ void initializeSimulation() {
     std::cout << "\n=== SIMULATION TERMINÉE ===\n";
 }
 
-int main() {
-    initializeSimulation();
+// Usage : ProjetCPP [--headless [heures]] [--evenements] [--trace fichier] [--threads n] [--graine n]
+//                   [--historique repertoire]
+// --evenements : simulation sans affichage en mode événementiel (les avions
+// en attente au parking ou en croisière ne sont réveillés qu'à la fin de leur phase).
+// Avec --trace, les journaux sont écrits dans une trace binaire unique
+// (convertible en JSON avec TraceVersJSON) au lieu des fichiers log_*.json.
+// Sans --graine, une graine aléatoire est tirée et affichée pour pouvoir
+// rejouer le scénario.
+// --historique : répertoire des segments d'historique des contrôleurs
+// (répertoire temporaire du système par défaut).
+int main(int argc, char* argv[]) {
+    bool sansAffichage = false;
+    bool evenementiel = false;
+    double heures = 24.0;
+    std::string cheminTrace;
+    ConfigurationHistorique historique;
+    size_t nbThreads = 0;
+    bool graineFixee = false;
+    unsigned long long graine = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            sansAffichage = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                heures = std::atof(argv[++i]);
+            }
+        }
+        else if (std::strcmp(argv[i], "--evenements") == 0) {
+            sansAffichage = true;
+            evenementiel = true;
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            cheminTrace = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--historique") == 0 && i + 1 < argc) {
+            historique.repertoire = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            nbThreads = static_cast<size_t>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--graine") == 0 && i + 1 < argc) {
+            graine = std::strtoull(argv[++i], nullptr, 0);
+            graineFixee = true;
+        }
+    }
+
+    if (!graineFixee) {
+        std::random_device rd;
+        graine = (static_cast<unsigned long long>(rd()) << 32) ^ rd();
+    }
+    Avion::setGraineScenario(graine);
+    std::cout << "Graine du scenario : " << graine << "\n";
+
+    ControleurBase::configurerHistorique(historique);
+
+    std::unique_ptr<TraceBinaire> trace;
+    if (!cheminTrace.empty()) {
+        trace.reset(new TraceBinaire(cheminTrace));
+        if (!trace->estOuverte()) {
+            std::cerr << "Impossible d'ouvrir la trace " << cheminTrace << "\n";
+            return 1;
+        }
+        ControleurBase::configurerJournaux(false, trace.get());
+    }
+
+    initializeSimulation(sansAffichage, heures * 3600.0, nbThreads, evenementiel);
+
+    if (trace) {
+        ControleurBase::configurerJournaux(true, nullptr);
+        trace->fermer();
+        std::cout << "Trace : " << trace->getNbEnregistrements() << " evenements dans "
+            << cheminTrace << "\n";
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "../include/Avion.h"
+#include "../include/Flotte.h"
+#include "../include/PlanVol.h"
+#include "Verification.h"
+#include <memory>
+#include <vector>
+
+namespace {
+
+    std::vector<Position> route(const Position& depart, const Position& arrivee) {
+        Position milieu((depart.x + arrivee.x) / 2.0, (depart.y + arrivee.y) / 2.0, 10000.0);
+        return { depart, milieu, arrivee };
+    }
+
+    void testReseauRoutes() {
+        ReseauRoutes reseau;
+        VERIFIER(!reseau.trouver(Position(0.0, 0.0, 0.0), Position(0.0, 100000.0, 0.0)));
+
+        // Arrivée au bord d'une cellule de l'index, puis une route voisine
+        // déclarée plus tard : la première déclarée l'emporte
+        reseau.ajouter(route(Position(0.0, 0.0, 0.0), Position(9999.0, 100000.0, 0.0)));
+        reseau.ajouter(route(Position(100.0, 0.0, 0.0), Position(10001.0, 100000.0, 0.0)));
+        reseau.ajouter(route(Position(0.0, 100000.0, 0.0), Position(0.0, 0.0, 0.0)));
+
+        std::shared_ptr<const RouteDeclaree> r = reseau.trouver(Position(50.0, 0.0, 0.0), Position(10002.0, 100000.0, 0.0));
+        VERIFIER(r && r->arrivee.x == 9999.0);
+        VERIFIER(r == reseau.trouver(Position(0.0, 0.0, 0.0), Position(9999.0, 100000.0, 0.0)));
+        VERIFIER(reseau.trouver(Position(0.0, 100000.0, 0.0), Position(0.0, 0.0, 0.0))->points.size() == 3);
+
+        // Hors tolérance, au départ comme à l'arrivée
+        VERIFIER(!reseau.trouver(Position(20000.0, 0.0, 0.0), Position(9999.0, 100000.0, 0.0)));
+        VERIFIER(!reseau.trouver(Position(0.0, 0.0, 0.0), Position(30000.0, 100000.0, 0.0)));
+
+        // Une route déjà obtenue survit au vidage du réseau
+        reseau.vider();
+        VERIFIER(!reseau.trouver(Position(0.0, 0.0, 0.0), Position(9999.0, 100000.0, 0.0)));
+        VERIFIER(r->points.size() == 3);
+    }
+
+    // La publication ne positionne pas les avions en croisière : le lecteur
+    // évalue le plan publié au temps de l'instantané
+    void testCroisierePubliee() {
+        HorlogeVirtuelle horloge;
+        Avion::setHorloge(horloge);
+        Flotte flotte(16);
+
+        std::vector<Position> destinations = { Position(0.0, 200000.0, 0.0) };
+        Avion avion("CROISIERE", Position(0.0, 0.0, 10000.0), destinations, flotte);
+        size_t i = avion.getIndice();
+
+        std::vector<Position> points = { Position(0.0, 0.0, 0.0), Position(100000.0, 0.0, 0.0), Position(100000.0, 200000.0, 0.0) };
+        std::shared_ptr<const PlanVol> plan = std::make_shared<PlanVol>(points);
+        flotte.etat[i] = static_cast<std::uint8_t>(EtatAvion::CROISIERE);
+        flotte.demarrerCroisiere(i, plan, 0.0);
+        const double x0 = flotte.x[i];
+        const double y0 = flotte.y[i];
+
+        // Second tronçon : 12,5 km/s le long du plan
+        const double t = 10.0;
+        flotte.publier(t);
+        VERIFIER(flotte.x[i] == x0 && flotte.y[i] == y0);
+
+        LectureFlotte lecture = flotte.lire();
+        EtatPublie publie = lecture.etat(&avion);
+        Position attendue = flotte.positionCroisiere(i, t);
+        VERIFIER(publie.x == attendue.x && publie.y == attendue.y);
+        VERIFIER(publie.x == 100000.0 && publie.y == 25000.0);
+        VERIFIER(publie.dirX == 0.0 && publie.dirY == 1.0);
+        VERIFIER(lecture.getInstantane()->croisieres[0].plan == plan);
+
+        // Cap lu directement : celui du tronçon de l'instantané
+        VERIFIER(avion.getVitesseX() == 0.0 && avion.getVitesseY() > 0.0);
+
+        // L'empreinte ne dépend pas de l'évaluation des colonnes
+        const std::uint64_t empreinte = flotte.empreinte();
+        flotte.evaluerCroisiere(i, t);
+        VERIFIER(flotte.empreinte() == empreinte);
+        lecture.liberer();
+
+        // Sortie de croisière imposée : l'avion repart de la position publiée
+        flotte.x[i] = x0;
+        flotte.y[i] = y0;
+        avion.setEtat(EtatAvion::DESCENTE);
+        VERIFIER(flotte.x[i] == 100000.0 && flotte.y[i] == 25000.0);
+
+        flotte.publier(t + 1.0);
+        LectureFlotte apres = flotte.lire();
+        VERIFIER(!apres.getInstantane()->croisieres[0].plan);
+    }
+
+} // namespace
+
+int main() {
+    testReseauRoutes();
+    testCroisierePubliee();
+    return Verification::bilan("TestCroisiere");
+}
@@ -0,0 +1,138 @@
+#include "../include/FileSPSC.h"
+#include "Verification.h"
+#include <thread>
+
+namespace {
+
+    void testCapacite() {
+        VERIFIER(FileSPSC<int>(1).getCapacite() == 2);
+        VERIFIER(FileSPSC<int>(3).getCapacite() == 4);
+        VERIFIER(FileSPSC<int>(256).getCapacite() == 256);
+        VERIFIER(FileSPSC<int>(257).getCapacite() == 512);
+    }
+
+    void testPleineEtVide() {
+        FileSPSC<int> file(4);
+        int v = -1;
+        VERIFIER(file.estVide());
+        VERIFIER(!file.retirer(v));
+
+        for (int i = 0; i < 4; i++) {
+            VERIFIER(file.deposer(i));
+        }
+        VERIFIER(!file.deposer(4));
+        VERIFIER(!file.estVide());
+
+        // Une place libérée suffit à accepter un nouveau dépôt
+        VERIFIER(file.retirer(v) && v == 0);
+        VERIFIER(file.deposer(4));
+        VERIFIER(!file.deposer(5));
+
+        for (int i = 1; i <= 4; i++) {
+            VERIFIER(file.retirer(v) && v == i);
+        }
+        VERIFIER(!file.retirer(v));
+        VERIFIER(file.estVide());
+    }
+
+    void testTourDuTableau() {
+        // Les indices dépassent largement la capacité : l'ordre tient au masque
+        FileSPSC<int> file(8);
+        int attendu = 0;
+        int suivant = 0;
+        bool ordre = true;
+        for (int tour = 0; tour < 1000; tour++) {
+            for (int k = 0; k < 1 + tour % 8; k++) {
+                if (file.deposer(suivant)) suivant++;
+            }
+            int v;
+            for (int k = 0; k < 1 + (tour * 3) % 8; k++) {
+                if (file.retirer(v)) {
+                    ordre = ordre && v == attendu;
+                    attendu++;
+                }
+            }
+        }
+        VERIFIER(ordre);
+        VERIFIER(attendu <= suivant);
+        VERIFIER(suivant - attendu <= 8);
+    }
+
+    void testFlux() {
+        // Un producteur et un consommateur sur une petite file : tout arrive,
+        // dans l'ordre
+        const int N = 1000000;
+        FileSPSC<int> file(16);
+        long long somme = 0;
+        bool ordre = true;
+
+        std::thread consommateur([&]() {
+            int attendu = 0;
+            int v;
+            while (attendu < N) {
+                if (!file.retirer(v)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ordre = ordre && v == attendu;
+                somme += v;
+                attendu++;
+            }
+        });
+
+        for (int i = 0; i < N;) {
+            if (file.deposer(i)) i++;
+            else std::this_thread::yield();
+        }
+        consommateur.join();
+
+        VERIFIER(ordre);
+        VERIFIER(somme == static_cast<long long>(N) * (N - 1) / 2);
+        VERIFIER(file.estVide());
+    }
+
+    void testPingPong() {
+        // Deux files en sens opposés, comme les canaux de passation entre
+        // deux contrôleurs : chaque valeur revient incrémentée
+        const int N = 100000;
+        FileSPSC<int> aller(2);
+        FileSPSC<int> retour(2);
+        bool ordre = true;
+
+        std::thread echo([&]() {
+            int v = 0;
+            for (int recus = 0; recus < N;) {
+                if (!aller.retirer(v)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                while (!retour.deposer(v + 1)) std::this_thread::yield();
+                recus++;
+            }
+        });
+
+        int v = 0;
+        for (int i = 0; i < N; i++) {
+            while (!aller.deposer(v)) std::this_thread::yield();
+            int r;
+            while (!retour.retirer(r)) std::this_thread::yield();
+            ordre = ordre && r == v + 1;
+            v = r;
+        }
+        echo.join();
+
+        VERIFIER(ordre);
+        VERIFIER(v == N);
+        VERIFIER(aller.estVide() && retour.estVide());
+    }
+
+} // namespace
+
+int main() {
+    testCapacite();
+    testPleineEtVide();
+    testTourDuTableau();
+    testFlux();
+    testPingPong();
+    return Verification::bilan("TestFileSPSC");
+}
@@ -0,0 +1,90 @@
+#include "../include/JournalAsynchrone.h"
+#include "../include/Message.h"
+#include "Verification.h"
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    const int NB_TOURS = 20;
+    const int MESSAGES_PAR_TOUR = 50;
+    const char* const CHEMIN = "test_journal_ordre.json";
+
+    // Horodatages relevés dans le fichier, dans l'ordre d'écriture
+    std::vector<long long> lireHorodatages(const char* chemin) {
+        std::ifstream fichier(chemin);
+        std::stringstream contenu;
+        contenu << fichier.rdbuf();
+        const std::string texte = contenu.str();
+
+        std::vector<long long> horodatages;
+        const std::string cle = "\"timestamp\":";
+        for (size_t p = texte.find(cle); p != std::string::npos; p = texte.find(cle, p + 1)) {
+            horodatages.push_back(std::stoll(texte.substr(p + cle.size())));
+        }
+        return horodatages;
+    }
+
+    // Deux threads écrivent à tour de rôle dans le même fichier, comme les
+    // cycles d'un contrôleur repris par différents threads du pool ; aucun
+    // relevé entre deux tours
+    void testOrdreEntreThreads() {
+        std::remove(CHEMIN);
+
+        ConfigurationJournal configuration;
+        configuration.intervalleVidageMs = 60000;
+        JournalAsynchrone journal(configuration);
+        int idFlux = journal.ouvrir(CHEMIN);
+        VERIFIER(idFlux >= 0);
+
+        std::mutex mtx;
+        std::condition_variable cv;
+        int tour = 0;
+        long long prochain = 0;
+
+        auto producteur = [&](int parite) {
+            for (int t = parite; t < NB_TOURS; t += 2) {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]() { return tour == t; });
+                for (int i = 0; i < MESSAGES_PAR_TOUR; i++) {
+                    Message msg;
+                    msg.type = TypeEvenement::AVION_AJOUTE;
+                    msg.timestamp = prochain++;
+                    journal.ecrire(idFlux, msg);
+                }
+                tour++;
+                cv.notify_all();
+            }
+        };
+
+        std::thread pair(producteur, 0);
+        std::thread impair(producteur, 1);
+        pair.join();
+        impair.join();
+
+        journal.fermer(idFlux);
+        VERIFIER(journal.getStatistiques().abandonnes == 0);
+
+        std::vector<long long> horodatages = lireHorodatages(CHEMIN);
+        VERIFIER(horodatages.size() == static_cast<size_t>(NB_TOURS * MESSAGES_PAR_TOUR));
+        bool ordonnes = true;
+        for (size_t i = 0; i < horodatages.size(); i++) {
+            ordonnes = ordonnes && horodatages[i] == static_cast<long long>(i);
+        }
+        VERIFIER(ordonnes);
+
+        std::remove(CHEMIN);
+    }
+
+} // namespace
+
+int main() {
+    testOrdreEntreThreads();
+    return Verification::bilan("TestJournalAsynchrone");
+}
@@ -0,0 +1,143 @@
+#include "../include/APP.h"
+#include "../include/TWR.h"
+#include "../include/Ordonnanceur.h"
+#include "../include/PoolAvions.h"
+#include "Verification.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+    const double DT = 0.05;
+    const double PERIODE_APP = 0.3;
+    const double PERIODE_TWR = 1.0;     // La TWR ne constate la libération qu'après l'APP
+    const int PAS_MAX = 1000;
+    const double EPSILON = 1e-9;
+
+    // Demande l'atterrissage d'un autre avion à l'APP, en vague 0 : la piste
+    // change pendant le pas, avant les cycles de la TWR et de l'APP
+    class Pilote : public ControleurBase {
+    private:
+        APP& app;
+        bool demande;
+        bool repondu;
+        bool accorde;
+
+        void processLogic() override {
+            if (!demande) return;
+            accorde = app.demanderAutorisationAtterrissage("AUTRE");
+            demande = false;
+            repondu = true;
+        }
+
+    public:
+        explicit Pilote(APP& app)
+            : ControleurBase("Pilote_" + app.getNom()), app(app), demande(false),
+            repondu(false), accorde(false) {
+        }
+
+        void demander() { demande = true; }
+        bool aRepondu() const { return repondu; }
+        bool estAccorde() const { return accorde; }
+    };
+
+    // TWR en vague 1, APP en vague 2, un avion en finale sous contrôle de l'APP
+    struct Aeroport {
+        Ordonnanceur ordonnanceur;
+        TWR twr;
+        APP app;
+        Pilote pilote;
+        Avion* avion;
+
+        explicit Aeroport(const std::string& nom)
+            : ordonnanceur(1, 60.0, 3.0),
+            twr("TWR_" + nom),
+            app("APP_" + nom, Position(0.0, 0.0, 0.0), 30000.0f, &twr, nullptr),
+            pilote(app),
+            avion(nullptr) {
+
+            twr.setHorloge(ordonnanceur.getHorloge());
+            app.setHorloge(ordonnanceur.getHorloge());
+            pilote.setHorloge(ordonnanceur.getHorloge());
+            ordonnanceur.ajouterControleur(&pilote, PERIODE_APP, 0);
+            ordonnanceur.ajouterControleur(&twr, PERIODE_TWR, 1);
+            ordonnanceur.ajouterControleur(&app, PERIODE_APP, 2);
+
+            PoolAvions& pool = PoolAvions::globale();
+            std::vector<Position> destinations = { Position(0.0, 0.0, 0.0) };
+            avion = pool.obtenir(pool.creer("FINALE_" + nom, Position(8000.0, 0.0, 500.0), destinations));
+            avion->setEtat(EtatAvion::ATTERRISSAGE);
+            ordonnanceur.ajouterAvion(avion);
+            app.ajouterAvionEnApproche(avion);
+        }
+
+        // Pas par pas jusqu'à la réponse du pilote ; faux s'il ne répond pas
+        bool demanderPiste() {
+            pilote.demander();
+            for (int i = 0; i < PAS_MAX && !pilote.aRepondu(); i++) {
+                ordonnanceur.tick(DT);
+            }
+            return pilote.aRepondu() && pilote.estAccorde();
+        }
+    };
+
+    void testPisteVueAuMemePas() {
+        Aeroport aeroport("Meme");
+        for (int i = 0; i < 10; i++) {
+            aeroport.ordonnanceur.tick(DT);
+        }
+        VERIFIER(aeroport.avion->getEtat() == EtatAvion::ATTERRISSAGE);
+
+        // Notification de la TWR relevée par l'APP au pas de l'autorisation
+        VERIFIER(aeroport.demanderPiste());
+        InstantanePiste piste = aeroport.twr.getEtatPiste();
+        VERIFIER(piste.occupee);
+        VERIFIER(aeroport.avion->getEtat() == EtatAvion::ATTENTE);
+
+        // Piste occupée : l'APP ne peut pas en obtenir une seconde
+        VERIFIER(!aeroport.app.demanderAutorisationAtterrissage("AUTRE2"));
+
+        // L'attente est levée au premier cycle de l'APP après l'heure de
+        // libération, avant que la TWR ne la constate
+        double liberation = -1.0;
+        for (int i = 0; i < PAS_MAX && liberation < 0.0; i++) {
+            double t = aeroport.ordonnanceur.getHorloge().maintenant();
+            aeroport.ordonnanceur.tick(DT);
+            if (aeroport.avion->getEtat() == EtatAvion::ATTERRISSAGE) liberation = t;
+        }
+        VERIFIER(liberation >= piste.heureLiberation - EPSILON);
+        VERIFIER(liberation < piste.heureLiberation + PERIODE_APP + EPSILON);
+        VERIFIER(aeroport.twr.getEtatPiste().occupee);
+    }
+
+    void testBoitePleine() {
+        Aeroport aeroport("Pleine");
+        for (int i = 0; i < 10; i++) {
+            aeroport.ordonnanceur.tick(DT);
+        }
+        VERIFIER(aeroport.avion->getEtat() == EtatAvion::ATTERRISSAGE);
+
+        // Boîte de l'APP pleine : la notification de la TWR est perdue
+        Message bourrage;
+        bourrage.type = TypeEvenement::AVION_AJOUTE;
+        bourrage.expediteur = static_cast<std::int16_t>(aeroport.pilote.getIdControleur());
+        bourrage.destinataire = static_cast<std::int16_t>(aeroport.app.getIdControleur());
+        while (aeroport.app.envoyerMessage(bourrage)) {
+        }
+        VERIFIER(!aeroport.app.envoyerMessage(bourrage));
+
+        // L'APP relit l'état publié (séquence en avance) au même pas
+        VERIFIER(aeroport.demanderPiste());
+        VERIFIER(aeroport.twr.getEtatPiste().occupee);
+        VERIFIER(aeroport.avion->getEtat() == EtatAvion::ATTENTE);
+    }
+
+} // namespace
+
+int main() {
+    ControleurBase::configurerJournaux(false, nullptr);
+
+    testPisteVueAuMemePas();
+    testBoitePleine();
+    return Verification::bilan("TestPiste");
+}
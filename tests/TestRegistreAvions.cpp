@@ -0,0 +1,95 @@
+#include "../include/RegistreAvions.h"
+#include "Verification.h"
+#include <memory>
+#include <string>
+
+namespace {
+
+    const size_t NB_VOLS = 10 * RegistreAvions::QUARANTAINE;
+
+    std::string nomVol(size_t i) {
+        return "VOL" + std::to_string(i);
+    }
+
+    // Un vol à la fois, chacun sous un nouveau nom : le registre reste borné
+    // par la quarantaine, et le plus ancien identifiant revient en premier
+    void testRecyclage() {
+        std::unique_ptr<RegistreAvions> registre(new RegistreAvions());
+
+        IdAvion premier = registre->acquerir(nomVol(0));
+        registre->attribuer(premier, 3);
+        registre->relacher(premier);
+        VERIFIER(registre->trouver(nomVol(0)) == RegistreAvions::ID_INVALIDE);
+        VERIFIER(registre->getNom(premier) == nomVol(0));
+
+        bool enQuarantaine = true;
+        for (size_t i = 1; i <= RegistreAvions::QUARANTAINE; i++) {
+            IdAvion id = registre->acquerir(nomVol(i));
+            enQuarantaine = enQuarantaine && id != premier;
+            registre->relacher(id);
+        }
+        VERIFIER(enQuarantaine);
+
+        // Sortie de quarantaine : nouveau nom, propriétaire remis à zéro
+        IdAvion repris = registre->acquerir(nomVol(RegistreAvions::QUARANTAINE + 1));
+        VERIFIER(repris == premier);
+        VERIFIER(registre->getNom(repris) == nomVol(RegistreAvions::QUARANTAINE + 1));
+        VERIFIER(registre->proprietaire(repris) == RegistreAvions::AUCUN_CONTROLEUR);
+        registre->relacher(repris);
+
+        for (size_t i = RegistreAvions::QUARANTAINE + 2; i < NB_VOLS; i++) {
+            registre->relacher(registre->acquerir(nomVol(i)));
+        }
+        VERIFIER(registre->taille() == RegistreAvions::QUARANTAINE + 1);
+    }
+
+    void testReferences() {
+        std::unique_ptr<RegistreAvions> registre(new RegistreAvions());
+
+        // Deux avions du même nom partagent l'identifiant
+        IdAvion id = registre->acquerir("DOUBLE");
+        VERIFIER(registre->acquerir("DOUBLE") == id);
+        registre->relacher(id);
+        VERIFIER(registre->trouver("DOUBLE") == id);
+        registre->relacher(id);
+        VERIFIER(registre->trouver("DOUBLE") == RegistreAvions::ID_INVALIDE);
+
+        // Un nom interné n'est jamais recyclé
+        IdAvion permanent = registre->interner("PERMANENT");
+        VERIFIER(registre->acquerir("PERMANENT") == permanent);
+        registre->relacher(permanent);
+        registre->relacher(permanent);
+        VERIFIER(registre->trouver("PERMANENT") == permanent);
+    }
+
+    // Trace ouverte : les identifiants gardent leur nom jusqu'à la reprise
+    void testSuspension() {
+        std::unique_ptr<RegistreAvions> registre(new RegistreAvions());
+
+        registre->suspendreRecyclage();
+        IdAvion premier = registre->acquerir(nomVol(0));
+        registre->relacher(premier);
+        for (size_t i = 1; i < 2 * RegistreAvions::QUARANTAINE; i++) {
+            registre->relacher(registre->acquerir(nomVol(i)));
+        }
+        VERIFIER(registre->taille() == 2 * RegistreAvions::QUARANTAINE);
+        VERIFIER(registre->trouver(nomVol(0)) == premier);
+        VERIFIER(registre->getNom(premier) == nomVol(0));
+        registre->reprendreRecyclage();
+
+        // Après la reprise, les nouveaux vols sont de nouveau recyclés
+        size_t avant = registre->taille();
+        for (size_t i = 0; i < NB_VOLS; i++) {
+            registre->relacher(registre->acquerir("APRES" + std::to_string(i)));
+        }
+        VERIFIER(registre->taille() == avant + RegistreAvions::QUARANTAINE + 1);
+    }
+
+} // namespace
+
+int main() {
+    testRecyclage();
+    testReferences();
+    testSuspension();
+    return Verification::bilan("TestRegistreAvions");
+}
@@ -0,0 +1,132 @@
+#include "../include/ReseauDestinations.h"
+#include "Verification.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    const int NB_TIRAGES = 200000;
+
+    // Aéroports sur une ligne, espacés de 100 km ; le dernier est à 10 km
+    // du premier (trop proche pour être une destination depuis celui-ci)
+    std::vector<Position> ligneAeroports() {
+        std::vector<Position> aeroports;
+        for (int i = 0; i < 5; i++) {
+            aeroports.push_back(Position(i * 100000.0, 0.0, 0.0));
+        }
+        aeroports.push_back(Position(10000.0, 0.0, 0.0));
+        return aeroports;
+    }
+
+    std::vector<double> frequences(const ReseauDestinations& reseau, size_t origine, FluxAleatoire& flux) {
+        std::vector<double> f(reseau.taille(), 0.0);
+        for (int i = 0; i < NB_TIRAGES; i++) {
+            f[reseau.tirer(origine, flux)] += 1.0 / NB_TIRAGES;
+        }
+        return f;
+    }
+
+    void testTiragePondere() {
+        // Depuis 0 : candidats 1 à 4, de poids 1, 2, 3 et 4 (l'aéroport 5 est trop proche)
+        std::vector<double> poids = { 7.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+        ReseauDestinations reseau(ligneAeroports(), poids);
+        FluxAleatoire flux(42, FluxAleatoire::sujet("pondere"), FluxAleatoire::DESTINATIONS);
+
+        VERIFIER(reseau.getTable(0).taille() == 4);
+
+        std::vector<double> f = frequences(reseau, 0, flux);
+        VERIFIER(f[0] == 0.0);
+        VERIFIER(f[5] == 0.0);
+        for (size_t i = 1; i <= 4; i++) {
+            VERIFIER(std::fabs(f[i] - i / 10.0) < 0.005);
+        }
+    }
+
+    void testTirageUniforme() {
+        ReseauDestinations reseau(ligneAeroports());
+        FluxAleatoire flux(42, FluxAleatoire::sujet("uniforme"), FluxAleatoire::DESTINATIONS);
+
+        std::vector<double> f = frequences(reseau, 0, flux);
+        for (size_t i = 1; i <= 4; i++) {
+            VERIFIER(std::fabs(f[i] - 0.25) < 0.005);
+        }
+        VERIFIER(f[0] == 0.0 && f[5] == 0.0);
+    }
+
+    void testPoidsNul() {
+        std::vector<double> poids = { 1.0, 0.0, 1.0, 0.0, 2.0, 1.0 };
+        ReseauDestinations reseau(ligneAeroports(), poids);
+        FluxAleatoire flux(7, FluxAleatoire::sujet("nul"), FluxAleatoire::DESTINATIONS);
+
+        std::vector<double> f = frequences(reseau, 0, flux);
+        VERIFIER(f[1] == 0.0);
+        VERIFIER(f[3] == 0.0);
+        VERIFIER(std::fabs(f[2] - 1.0 / 3.0) < 0.005);
+        VERIFIER(std::fabs(f[4] - 2.0 / 3.0) < 0.005);
+    }
+
+    void testRepli() {
+        // Tous les aéroports à moins de DISTANCE_MIN : le plus éloigné, sans tirage
+        std::vector<Position> proches = {
+            Position(0.0, 0.0, 0.0), Position(20000.0, 0.0, 0.0), Position(0.0, 30000.0, 0.0)
+        };
+        ReseauDestinations reseau(proches);
+        FluxAleatoire flux(1, FluxAleatoire::sujet("repli"), FluxAleatoire::DESTINATIONS);
+
+        VERIFIER(reseau.tirer(0, flux) == 2);
+        VERIFIER(reseau.tirer(1, flux) == 2);
+        VERIFIER(flux.getPosition() == 0);
+        VERIFIER(reseau.tirerDepuis(Position(0.0, 0.0, 0.0), flux) == 2);
+    }
+
+    void testTirerDepuis() {
+        // Hors réseau, mêmes candidats et mêmes probabilités que la table
+        std::vector<double> poids = { 7.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+        ReseauDestinations reseau(ligneAeroports(), poids);
+        FluxAleatoire flux(3, FluxAleatoire::sujet("depuis"), FluxAleatoire::DESTINATIONS);
+
+        std::vector<double> f(reseau.taille(), 0.0);
+        for (int i = 0; i < NB_TIRAGES; i++) {
+            f[reseau.tirerDepuis(Position(1000.0, 0.0, 0.0), flux)] += 1.0 / NB_TIRAGES;
+        }
+        VERIFIER(f[0] == 0.0 && f[5] == 0.0);
+        for (size_t i = 1; i <= 4; i++) {
+            VERIFIER(std::fabs(f[i] - i / 10.0) < 0.005);
+        }
+    }
+
+    void testReproductible() {
+        std::vector<double> poids = { 7.0, 1.0, 2.0, 3.0, 4.0, 5.0 };
+        ReseauDestinations reseau(ligneAeroports(), poids);
+        FluxAleatoire a(99, FluxAleatoire::sujet("AF123"), FluxAleatoire::DESTINATIONS);
+        FluxAleatoire b(99, FluxAleatoire::sujet("AF123"), FluxAleatoire::DESTINATIONS);
+
+        bool identiques = true;
+        for (int i = 0; i < 1000; i++) {
+            identiques = identiques && reseau.tirer(0, a) == reseau.tirer(0, b);
+        }
+        VERIFIER(identiques);
+    }
+
+    void testPartage() {
+        std::vector<Position> aeroports = ligneAeroports();
+        std::shared_ptr<const ReseauDestinations> r1 = ReseauDestinations::partager(aeroports);
+        std::shared_ptr<const ReseauDestinations> r2 = ReseauDestinations::partager(aeroports);
+        VERIFIER(r1 == r2);
+
+        aeroports.back().x += 1.0;
+        VERIFIER(ReseauDestinations::partager(aeroports) != r1);
+    }
+
+} // namespace
+
+int main() {
+    testTiragePondere();
+    testTirageUniforme();
+    testPoidsNul();
+    testRepli();
+    testTirerDepuis();
+    testReproductible();
+    testPartage();
+    return Verification::bilan("TestReseauDestinations");
+}
@@ -0,0 +1,138 @@
+#include "../include/SequenceAtterrissage.h"
+#include "../include/FluxAleatoire.h"
+#include "Verification.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    const int NB_OPERATIONS = 20000;
+    const int NB_AVIONS = 64;
+
+    // Séquence de référence : liste non triée, premier trouvé par parcours
+    struct Reference {
+        std::vector<CreneauAtterrissage> creneaux;
+        std::uint64_t prochainOrdre = 0;
+
+        static bool avant(const CreneauAtterrissage& a, const CreneauAtterrissage& b) {
+            if (a.priorite != b.priorite) return a.priorite > b.priorite;
+            if (a.heureEstimee != b.heureEstimee) return a.heureEstimee < b.heureEstimee;
+            return a.ordre < b.ordre;
+        }
+
+        CreneauAtterrissage* trouver(IdAvion avion) {
+            for (auto& c : creneaux) {
+                if (c.avion == avion) return &c;
+            }
+            return nullptr;
+        }
+
+        IdAvion premier() const {
+            return std::min_element(creneaux.begin(), creneaux.end(), avant)->avion;
+        }
+    };
+
+    void testExemple() {
+        SequenceAtterrissage sequence;
+        VERIFIER(sequence.estVide());
+
+        VERIFIER(sequence.inserer(1, 300.0));
+        VERIFIER(sequence.inserer(2, 100.0));
+        VERIFIER(sequence.inserer(3, 200.0));
+        VERIFIER(!sequence.inserer(2, 50.0));
+        VERIFIER(sequence.taille() == 3);
+        VERIFIER(sequence.premier().avion == 2);
+
+        // Nouvelle estimation : 1 passe devant
+        VERIFIER(sequence.reordonner(1, 50.0));
+        VERIFIER(sequence.premier().avion == 1);
+
+        // Urgence : 3 passe devant malgré son heure, puis redescend
+        VERIFIER(sequence.prioriser(3, PrioriteAtterrissage::URGENCE));
+        VERIFIER(sequence.premier().avion == 3);
+        VERIFIER(sequence.prioriser(3, PrioriteAtterrissage::NORMALE));
+        VERIFIER(sequence.premier().avion == 1);
+
+        // Égalité d'heure : l'ordre d'arrivée départage
+        VERIFIER(sequence.reordonner(2, 50.0));
+        VERIFIER(sequence.premier().avion == 1);
+
+        VERIFIER(sequence.retirer(1));
+        VERIFIER(!sequence.retirer(1));
+        VERIFIER(!sequence.contient(1));
+        VERIFIER(!sequence.reordonner(1, 10.0));
+        VERIFIER(sequence.extrairePremier() == 2);
+        VERIFIER(sequence.extrairePremier() == 3);
+        VERIFIER(sequence.estVide());
+    }
+
+    void testContreReference() {
+        SequenceAtterrissage sequence;
+        Reference reference;
+        FluxAleatoire flux(5, FluxAleatoire::sujet("sequence"), FluxAleatoire::DESTINATIONS);
+
+        bool coherente = true;
+        for (int n = 0; n < NB_OPERATIONS; n++) {
+            IdAvion avion = static_cast<IdAvion>(flux.entier(0, NB_AVIONS - 1));
+            // Heures entières : beaucoup d'égalités à départager
+            double heure = flux.entier(0, 500);
+            CreneauAtterrissage* attendu = reference.trouver(avion);
+
+            switch (flux.entier(0, 3)) {
+            case 0: {
+                PrioriteAtterrissage priorite = flux.entier(0, 9) == 0
+                    ? PrioriteAtterrissage::URGENCE : PrioriteAtterrissage::NORMALE;
+                coherente = coherente && sequence.inserer(avion, heure, priorite) == (attendu == nullptr);
+                if (attendu == nullptr) {
+                    CreneauAtterrissage c;
+                    c.avion = avion;
+                    c.heureEstimee = heure;
+                    c.priorite = priorite;
+                    c.ordre = reference.prochainOrdre++;
+                    reference.creneaux.push_back(c);
+                }
+                break;
+            }
+            case 1:
+                coherente = coherente && sequence.reordonner(avion, heure) == (attendu != nullptr);
+                if (attendu != nullptr) attendu->heureEstimee = heure;
+                break;
+            case 2: {
+                PrioriteAtterrissage priorite = flux.entier(0, 1) == 0
+                    ? PrioriteAtterrissage::URGENCE : PrioriteAtterrissage::NORMALE;
+                coherente = coherente && sequence.prioriser(avion, priorite) == (attendu != nullptr);
+                if (attendu != nullptr) attendu->priorite = priorite;
+                break;
+            }
+            default:
+                coherente = coherente && sequence.retirer(avion) == (attendu != nullptr);
+                if (attendu != nullptr) {
+                    reference.creneaux.erase(reference.creneaux.begin() + (attendu - &reference.creneaux[0]));
+                }
+                break;
+            }
+
+            coherente = coherente && sequence.taille() == reference.creneaux.size();
+            if (!reference.creneaux.empty()) {
+                coherente = coherente && sequence.premier().avion == reference.premier();
+            }
+        }
+        VERIFIER(coherente);
+
+        // Vidage complet dans l'ordre de référence
+        std::sort(reference.creneaux.begin(), reference.creneaux.end(), Reference::avant);
+        bool ordonnee = true;
+        for (const auto& c : reference.creneaux) {
+            ordonnee = ordonnee && !sequence.estVide() && sequence.extrairePremier() == c.avion;
+        }
+        VERIFIER(ordonnee);
+        VERIFIER(sequence.estVide());
+    }
+
+} // namespace
+
+int main() {
+    testExemple();
+    testContreReference();
+    return Verification::bilan("TestSequenceAtterrissage");
+}
@@ -0,0 +1,93 @@
+#include "../include/CCR.h"
+#include "../include/Ordonnanceur.h"
+#include "../include/PoolAvions.h"
+#include "Verification.h"
+#include <string>
+
+namespace {
+
+    const double DT = 0.05;
+    const int PAS_MAX = 200000;        // Près de 3 h simulées : largement de quoi atterrir
+
+    // Avance jusqu'à ce que le pool retombe à vivants avions ; faux sinon
+    bool attendreVivants(Ordonnanceur& ordonnanceur, size_t vivants) {
+        for (int i = 0; i < PAS_MAX; i++) {
+            ordonnanceur.tick(DT);
+            if (PoolAvions::globale().getStatistiques().vivants == vivants) return true;
+        }
+        return false;
+    }
+
+    void testVolsRecycles() {
+        Ordonnanceur ordonnanceur(1, 60.0, 3.0);
+        CCR ccr("CCR_Test", 10000.0);
+        ccr.setHorloge(ordonnanceur.getHorloge());
+        ordonnanceur.ajouterControleur(&ccr, 0.3, 0);
+
+        ccr.ajouterAeroport("Nord", Position(0.0, 0.0, 0.0), nullptr, 4);
+        ccr.ajouterAeroport("Sud", Position(0.0, 150000.0, 0.0), nullptr, 4);
+        ccr.ajouterRoute("Nord", "Sud");
+        ccr.ajouterRoute("Sud", "Nord");
+
+        const StatistiquesPool avant = PoolAvions::globale().getStatistiques();
+
+        // La demande ne crée rien : l'avion naît au pas suivant
+        ccr.creerVol("VOL1", "Nord", "Sud");
+        VERIFIER(PoolAvions::globale().getStatistiques().crees == avant.crees);
+        ordonnanceur.tick(DT);
+        VERIFIER(PoolAvions::globale().getStatistiques().crees == avant.crees + 1);
+        VERIFIER(ordonnanceur.getNbAvions() == 1);
+        VERIFIER(ccr.getAvions().size() == 1);
+
+        // Stationné à l'arrivée : rendu au pool
+        VERIFIER(attendreVivants(ordonnanceur, avant.vivants));
+        VERIFIER(ordonnanceur.getNbAvions() == 0);
+
+        // Le vol suivant réutilise l'emplacement libéré
+        ccr.creerVol("VOL2", "Sud", "Nord");
+        ordonnanceur.tick(DT);
+        StatistiquesPool apres = PoolAvions::globale().getStatistiques();
+        VERIFIER(apres.crees == avant.crees + 2);
+        VERIFIER(apres.recycles == avant.recycles + 1);
+        VERIFIER(apres.emplacements == avant.emplacements + 1);
+
+        // À son cycle suivant, le CCR oublie le premier vol (poignée
+        // périmée) et ne suit plus que le second
+        for (int i = 0; i < 10; i++) {
+            ordonnanceur.tick(DT);
+        }
+        VERIFIER(ccr.getAvions().size() == 1);
+
+        VERIFIER(attendreVivants(ordonnanceur, avant.vivants));
+    }
+
+    void testVolRefuse() {
+        Ordonnanceur ordonnanceur(1, 60.0, 3.0);
+        CCR ccr("CCR_Refus", 10000.0);
+        ccr.setHorloge(ordonnanceur.getHorloge());
+        ordonnanceur.ajouterControleur(&ccr, 0.3, 0);
+
+        ccr.ajouterAeroport("Nord", Position(0.0, 0.0, 0.0), nullptr, 1);
+        ccr.ajouterAeroport("Sud", Position(0.0, 150000.0, 0.0), nullptr, 1);
+
+        const StatistiquesPool avant = PoolAvions::globale().getStatistiques();
+
+        // Aéroport inconnu, puis capacité d'arrivée déjà réservée
+        ccr.creerVol("VOL3", "Nord", "Ouest");
+        ccr.creerVol("VOL4", "Nord", "Sud");
+        ccr.creerVol("VOL5", "Nord", "Sud");
+        ordonnanceur.tick(DT);
+        VERIFIER(PoolAvions::globale().getStatistiques().crees == avant.crees + 1);
+
+        VERIFIER(attendreVivants(ordonnanceur, avant.vivants));
+    }
+
+} // namespace
+
+int main() {
+    ControleurBase::configurerJournaux(false, nullptr);
+
+    testVolsRecycles();
+    testVolRefuse();
+    return Verification::bilan("TestVolsCCR");
+}
@@ -0,0 +1,35 @@
+#ifndef VERIFICATION_H
+#define VERIFICATION_H
+
+#include <iostream>
+
+// Vérifications des tests unitaires : un échec est signalé (fichier, ligne,
+// expression) sans interrompre le test ; le code de sortie donne le bilan.
+namespace Verification {
+
+    inline int& nbEchecs() {
+        static int n = 0;
+        return n;
+    }
+
+    inline void verifier(bool ok, const char* expression, const char* fichier, int ligne) {
+        if (ok) return;
+        nbEchecs()++;
+        std::cerr << fichier << ":" << ligne << " : echec de " << expression << "\n";
+    }
+
+    // Code de sortie du test : 0 si toutes les vérifications ont réussi
+    inline int bilan(const char* nom) {
+        if (nbEchecs() == 0) {
+            std::cout << nom << " : OK\n";
+            return 0;
+        }
+        std::cout << nom << " : " << nbEchecs() << " echec(s)\n";
+        return 1;
+    }
+
+} // namespace Verification
+
+#define VERIFIER(expression) Verification::verifier((expression), #expression, __FILE__, __LINE__)
+
+#endif // VERIFICATION_H